@@ -1,10 +1,18 @@
 // main.cpp
 #include <windows.h>
-#include "sqlite3.h"
+#include <windowsx.h>
+#include "notes_layout.h"
+#include "notes_resident.h"
+#include "notes_slowlog.h"
+#include "notes_trace.h"
+#include "notes_watchdog.h"
+#include "notes_worker.h"
 #include <string>
 #include <vector>
 #include <sstream>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <algorithm>
 
 // ---------------- constants & globals ----------------
@@ -12,185 +20,92 @@ const char g_szClassName[] = "notepadApp";
 const int ID_SEARCH = 100;
 const int ID_BTN_ADD = 101;
 const UINT MSG_REFRESH = WM_USER + 1;
+const UINT MSG_DB_RESULT = WM_USER + 2; // lParam = DbResult* from the db worker
 
 HWND hSearchBox = NULL;
 HWND hButtonAdd = NULL;
 HWND hMainWnd = NULL;
 
-sqlite3* db = nullptr;
-
 // font handles
 HFONT hFontBold = NULL;
 HFONT hFontNormal = NULL;
 
-// structure to track card rectangles and note ids
-struct CardInfo {
-    RECT rc;
-    int noteId;
-};
-std::vector<CardInfo> g_cards;
-
-// ---------------- SQLite helpers ----------------
-bool initDatabase() {
-    int rc = sqlite3_open("notes.db", &db);
-    if (rc != SQLITE_OK) {
-        MessageBoxA(NULL, sqlite3_errmsg(db), "DB Open Error", MB_OK | MB_ICONERROR);
-        if (db) sqlite3_close(db);
-        db = nullptr;
-        return false;
-    }
-    const char* sql =
-        "CREATE TABLE IF NOT EXISTS notes ("
-        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-        "title TEXT, "
-        "content TEXT);";
-    char* errmsg = nullptr;
-    rc = sqlite3_exec(db, sql, nullptr, nullptr, &errmsg);
-    if (rc != SQLITE_OK) {
-        std::string msg = "DB Init Error: ";
-        msg += errmsg ? errmsg : "";
-        MessageBoxA(NULL, msg.c_str(), "DB Error", MB_OK | MB_ICONERROR);
-        sqlite3_free(errmsg);
-        sqlite3_close(db);
-        db = nullptr;
-        return false;
+// the card grid: one owner-drawn child window painting from g_notes,
+// only the cards inside the viewport are drawn (see notes_layout.h)
+const char g_szGridClass[] = "noteGrid";
+const int GRID_TOP = 44; // leave space for search box
+HWND hGrid = NULL;
+std::vector<Note> g_notes; // id DESC, content is already a preview
+GridLayout g_grid;
+int g_scrollY = 0;
+
+// keyset state of the list in g_notes: rows with id >= g_listBefore are all
+// loaded; while g_listMore, the next page is fetched ahead of the scroll position
+uint64_t g_listSeq = 0;
+std::string g_listQuery;
+int g_listBefore = 0;
+bool g_listMore = false;
+bool g_pageInFlight = false;
+
+LRESULT CALLBACK NoteWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+
+// span name for the messages the window procs handle; the rest (mouse moves,
+// hit tests, ...) go to DefWindowProc and are not traced
+const char* traceMsgName(UINT msg) {
+    switch (msg) {
+    case WM_CREATE: return "WM_CREATE";
+    case WM_PAINT: return "WM_PAINT";
+    case WM_ERASEBKGND: return "WM_ERASEBKGND";
+    case WM_SIZE: return "WM_SIZE";
+    case WM_VSCROLL: return "WM_VSCROLL";
+    case WM_MOUSEWHEEL: return "WM_MOUSEWHEEL";
+    case WM_LBUTTONDOWN: return "WM_LBUTTONDOWN";
+    case WM_COMMAND: return "WM_COMMAND";
+    case WM_CLOSE: return "WM_CLOSE";
+    case WM_DESTROY: return "WM_DESTROY";
+    case MSG_REFRESH: return "MSG_REFRESH";
+    case MSG_DB_RESULT: return "MSG_DB_RESULT";
     }
-    return true;
+    return nullptr;
 }
 
-bool insertNotePrepared(const std::string& title, const std::string& content) {
-    if (!db) return false;
-    const char* sql = "INSERT INTO notes (title, content) VALUES (?, ?);";
-    sqlite3_stmt* stmt = nullptr;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
-        sqlite3_finalize(stmt);
-        return false;
-    }
-    sqlite3_bind_text(stmt, 1, title.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, content.c_str(), -1, SQLITE_TRANSIENT);
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return (rc == SQLITE_DONE);
+// ---------------- DB worker glue ----------------
+// called on the worker thread: hand the result to the window that asked for it
+void onDbResult(DbResult* result) {
+    HWND target = result->replyTo ? (HWND)result->replyTo : hMainWnd;
+    if (!target || !PostMessage(target, MSG_DB_RESULT, 0, (LPARAM)result)) delete result;
 }
 
-bool updateNotePrepared(int id, const std::string& title, const std::string& content) {
-    if (!db) return false;
-    const char* sql = "UPDATE notes SET title = ?, content = ? WHERE id = ?;";
-    sqlite3_stmt* stmt = nullptr;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
-        sqlite3_finalize(stmt);
-        return false;
-    }
-    sqlite3_bind_text(stmt, 1, title.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, content.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 3, id);
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return (rc == SQLITE_DONE);
+// ---------------- UTF-8 <-> UTF-16 ----------------
+// notes are UTF-8 in the database; the edit controls and DrawText go through
+// the W calls, so text outside the ANSI code page survives the round trip
+std::wstring toWide(const std::string& s) {
+    if (s.empty()) return std::wstring();
+    int n = MultiByteToWideChar(CP_UTF8, 0, s.data(), (int)s.size(), NULL, 0);
+    std::wstring w(n, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, s.data(), (int)s.size(), &w[0], n);
+    return w;
 }
 
-// fetch notes (id, title, content)
-struct Note {
-    int id;
-    std::string title;
-    std::string content;
-};
-std::vector<Note> fetchNotes(const std::string& q = "") {
-    std::vector<Note> out;
-    if (!db) return out;
-    std::string sql = "SELECT id, title, content FROM notes ";
-    if (!q.empty()) {
-        sql += "WHERE title LIKE ? OR content LIKE ? ";
-    }
-    sql += "ORDER BY id DESC;";
-    sqlite3_stmt* stmt = nullptr;
-    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return out;
-    if (!q.empty()) {
-        std::string p = "%" + q + "%";
-        sqlite3_bind_text(stmt, 1, p.c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_bind_text(stmt, 2, p.c_str(), -1, SQLITE_TRANSIENT);
-    }
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        Note n;
-        n.id = sqlite3_column_int(stmt, 0);
-        const unsigned char* t = sqlite3_column_text(stmt, 1);
-        const unsigned char* c = sqlite3_column_text(stmt, 2);
-        n.title = t ? (const char*)t : "";
-        n.content = c ? (const char*)c : "";
-        out.push_back(n);
-    }
-    sqlite3_finalize(stmt);
-    return out;
+std::string windowTextUtf8(HWND hwnd) {
+    int len = GetWindowTextLengthW(hwnd);
+    if (len <= 0) return std::string();
+    std::wstring w(len + 1, L'\0');
+    len = GetWindowTextW(hwnd, &w[0], len + 1);
+    int n = WideCharToMultiByte(CP_UTF8, 0, w.data(), len, NULL, 0, NULL, NULL);
+    std::string s(n, '\0');
+    WideCharToMultiByte(CP_UTF8, 0, w.data(), len, &s[0], n, NULL, NULL);
+    return s;
 }
 
-// ---------------- UI: helper to destroy only card children ----------------
-void clearCards(HWND hwndParent) {
-    // destroy children except search box and add button
-    HWND child = GetWindow(hwndParent, GW_CHILD);
-    while (child) {
-        HWND next = GetWindow(child, GW_HWNDNEXT);
-        if (child != hSearchBox && child != hButtonAdd) {
-            DestroyWindow(child);
-        }
-        child = next;
-    }
-    g_cards.clear();
+// ask the worker for the notes matching the current search text
+void requestNotes() {
+    TRACE_SCOPE("requestNotes");
+    submitSearch(hSearchBox ? windowTextUtf8(hSearchBox) : std::string(), hMainWnd);
 }
 
 // ---------------- UI: show notes in grid 2-cols ----------------
-void showNotes(HWND hwndParent, const std::string& search = "") {
-    // keep search text (so it doesn't disappear)
-    char buf[512] = {0};
-    if (hSearchBox) GetWindowTextA(hSearchBox, buf, (int)sizeof(buf));
-    // clear only card children
-    clearCards(hwndParent);
-
-    std::vector<Note> notes = fetchNotes(search.empty() ? std::string(buf) : search);
-
-    int margin = 10;
-    int cardW = 180;
-    int cardH = 110;
-    int x = margin;
-    int y = 50; // leave space for search box
-    int col = 0;
-
-    HINSTANCE hInst = GetModuleHandle(NULL);
-
-    for (auto &n : notes) {
-        // parent static card
-        HWND hCard = CreateWindowExA(WS_EX_CLIENTEDGE, "STATIC", "",
-            WS_CHILD | WS_VISIBLE, x, y, cardW, cardH, hwndParent, NULL, hInst, NULL);
-
-        // Title (bold)
-        HWND hTitle = CreateWindowA("STATIC", n.title.c_str(),
-            WS_CHILD | WS_VISIBLE | SS_LEFT, 8, 8, cardW - 16, 22, hCard, NULL, hInst, NULL);
-        SendMessage(hTitle, WM_SETFONT, (WPARAM)hFontBold, TRUE);
-
-        // Content (normal) - show only first lines/limit length
-        std::string contentPreview = n.content;
-        if (contentPreview.size() > 300) contentPreview = contentPreview.substr(0, 300) + "...";
-        HWND hContent = CreateWindowA("STATIC", contentPreview.c_str(),
-            WS_CHILD | WS_VISIBLE | SS_LEFT, 8, 34, cardW - 16, cardH - 42, hCard, NULL, hInst, NULL);
-        SendMessage(hContent, WM_SETFONT, (WPARAM)hFontNormal, TRUE);
-
-        // record card rect (relative to parent)
-        RECT rc;
-        SetRect(&rc, x, y, x + cardW, y + cardH);
-        g_cards.push_back({ rc, n.id });
-
-        // next position
-        col++;
-        if (col == 2) {
-            col = 0;
-            x = margin;
-            y += cardH + margin;
-        } else {
-            x += cardW + margin;
-        }
-    }
-
+void placeAddButton() {
     if (hButtonAdd) {
         RECT rc;
         GetClientRect(hMainWnd, &rc);
@@ -200,70 +115,304 @@ void showNotes(HWND hwndParent, const std::string& search = "") {
 
         SetWindowPos(hButtonAdd, HWND_TOP, btnX, btnY, btnW, btnH, SWP_SHOWWINDOW);
     }
+}
+
+int gridViewHeight() {
+    RECT rc;
+    GetClientRect(hGrid, &rc);
+    return rc.bottom - rc.top;
+}
+
+// ask for the next page once the viewport gets within a page of the end
+void requestMoreIfNeeded() {
+    if (!g_listMore || g_pageInFlight || !hGrid) return;
+    size_t first, last;
+    visibleRange(g_grid, g_notes.size(), g_scrollY, gridViewHeight(), &first, &last);
+    if (last + PAGE_ROWS < g_notes.size()) return;
+    submitPage(g_listSeq, g_listQuery, g_listBefore, hMainWnd);
+    g_pageInFlight = true;
+}
+
+// sync the scrollbar with the model size and repaint
+void updateGrid() {
+    if (!hGrid) return;
+    TRACE_SCOPE("updateGrid");
+    int viewH = gridViewHeight();
+    g_scrollY = clampScroll(g_grid, g_notes.size(), g_scrollY, viewH);
+
+    SCROLLINFO si{};
+    si.cbSize = sizeof(si);
+    si.fMask = SIF_RANGE | SIF_PAGE | SIF_POS;
+    si.nMin = 0;
+    si.nMax = contentHeight(g_grid, g_notes.size()) - 1;
+    si.nPage = (UINT)viewH;
+    si.nPos = g_scrollY;
+    SetScrollInfo(hGrid, SB_VERT, &si, TRUE);
+    InvalidateRect(hGrid, NULL, FALSE);
+    requestMoreIfNeeded();
+}
+
+// first page of a new search; takes over r->notes (swapped into g_notes)
+void showNotes(DbResult* r) {
+    TRACE_SCOPE_DETAIL("showNotes", nullptr, (long long)r->seq);
+    g_notes.swap(r->notes);
+    g_listSeq = r->seq;
+    g_listQuery = r->query;
+    g_listBefore = r->nextBefore;
+    g_listMore = r->more;
+    g_pageInFlight = false;
+    g_scrollY = 0;
+    updateGrid();
+    placeAddButton();
+}
+
+// a following page: append it if it still continues the list on screen
+void appendNotes(DbResult* r) {
+    TRACE_SCOPE_DETAIL("appendNotes", nullptr, (long long)r->seq);
+    if (r->seq != g_listSeq) return;
+    g_pageInFlight = false;
+    if (r->beforeId != g_listBefore) return;
+    g_notes.insert(g_notes.end(), r->notes.begin(), r->notes.end());
+    g_listBefore = r->nextBefore;
+    g_listMore = r->more;
+    updateGrid();
+}
+
+// patch the list with the rows a save touched instead of rebuilding it
+void applyNoteChanges(const std::vector<NoteChange>& changes) {
+    TRACE_SCOPE_DETAIL("applyNoteChanges", nullptr, (long long)changes.size());
+    for (auto& c : changes) {
+        // below the loaded range: the page that covers it will bring it
+        if (g_listMore && c.id < g_listBefore) continue;
+        size_t pos = 0;
+        while (pos < g_notes.size() && g_notes[pos].id > c.id) pos++; // list is id DESC
+        bool present = pos < g_notes.size() && g_notes[pos].id == c.id;
+
+        if (present && c.kind != ChangeKind::Deleted && c.matches) {
+            g_notes[pos] = c.note;
+        } else if (present) {
+            g_notes.erase(g_notes.begin() + pos);
+        } else if (c.kind != ChangeKind::Deleted && c.matches) {
+            g_notes.insert(g_notes.begin() + pos, c.note);
+        }
+    }
+    updateGrid();
+}
+
+void paintCard(HDC hdc, const Note& n, const RECT& rc) {
+    RECT card = rc;
+    FillRect(hdc, &card, (HBRUSH)(COLOR_WINDOW + 1));
+    DrawEdge(hdc, &card, EDGE_SUNKEN, BF_RECT);
+
+    // Title (bold)
+    RECT rt;
+    SetRect(&rt, rc.left + 8, rc.top + 8, rc.right - 8, rc.top + 30);
+    SelectObject(hdc, hFontBold);
+    std::wstring title = toWide(n.title);
+    DrawTextW(hdc, title.c_str(), (int)title.size(), &rt, DT_LEFT | DT_SINGLELINE | DT_END_ELLIPSIS | DT_NOPREFIX);
+
+    // Content (normal) - already cut to a preview by the worker
+    RECT rcContent;
+    SetRect(&rcContent, rc.left + 8, rc.top + 34, rc.right - 8, rc.bottom - 8);
+    SelectObject(hdc, hFontNormal);
+    std::wstring content = toWide(n.content);
+    DrawTextW(hdc, content.c_str(), (int)content.size(), &rcContent,
+        DT_LEFT | DT_WORDBREAK | DT_EDITCONTROL | DT_END_ELLIPSIS | DT_NOPREFIX);
+}
+
+void paintGrid(HWND hwnd, HDC hdc) {
+    TRACE_SCOPE("paintGrid");
+    RECT client;
+    GetClientRect(hwnd, &client);
+    int w = client.right, h = client.bottom;
+
+    // draw into a back buffer so scrolling doesn't flicker
+    HDC mem = CreateCompatibleDC(hdc);
+    HBITMAP bmp = CreateCompatibleBitmap(hdc, w, h);
+    HGDIOBJ oldBmp = SelectObject(mem, bmp);
+    HGDIOBJ oldFont = SelectObject(mem, hFontNormal);
+    FillRect(mem, &client, (HBRUSH)(COLOR_WINDOW + 1));
+    SetBkMode(mem, TRANSPARENT);
+
+    size_t first, last;
+    visibleRange(g_grid, g_notes.size(), g_scrollY, h, &first, &last);
+    for (size_t i = first; i < last; i++) {
+        GridRect gr = cardRect(g_grid, i);
+        RECT rc;
+        SetRect(&rc, gr.left, gr.top - g_scrollY, gr.right, gr.bottom - g_scrollY);
+        paintCard(mem, g_notes[i], rc);
+    }
+
+    BitBlt(hdc, 0, 0, w, h, mem, 0, 0, SRCCOPY);
+    SelectObject(mem, oldFont);
+    SelectObject(mem, oldBmp);
+    DeleteObject(bmp);
+    DeleteDC(mem);
+}
+
+void scrollGridTo(int y) {
+    y = clampScroll(g_grid, g_notes.size(), y, gridViewHeight());
+    if (y == g_scrollY) return;
+    g_scrollY = y;
+    SCROLLINFO si{};
+    si.cbSize = sizeof(si);
+    si.fMask = SIF_POS;
+    si.nPos = g_scrollY;
+    SetScrollInfo(hGrid, SB_VERT, &si, TRUE);
+    InvalidateRect(hGrid, NULL, FALSE);
+    requestMoreIfNeeded();
+}
+
+// open the editor window; noteId 0 => new note
+void openNoteEditor(HWND owner, intptr_t noteId) {
+    TRACE_SCOPE_DETAIL("openNoteEditor", nullptr, (long long)noteId);
+    WNDCLASSEX wcNote{};
+    wcNote.cbSize = sizeof(wcNote);
+    wcNote.lpfnWndProc = NoteWndProc;
+    wcNote.hInstance = GetModuleHandle(NULL);
+    wcNote.lpszClassName = "NoteWindowClass";
+    RegisterClassExA(&wcNote);
+
+    HWND note = CreateWindowExA(0, "NoteWindowClass", noteId > 0 ? "Edit Catatan" : "Catatan Baru",
+        WS_OVERLAPPEDWINDOW, CW_USEDEFAULT, CW_USEDEFAULT, 420, 380,
+        owner, NULL, GetModuleHandle(NULL), (LPVOID)noteId);
+    ShowWindow(note, SW_SHOW);
+}
+
+LRESULT CALLBACK GridWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+    TRACE_SCOPE_DETAIL(traceMsgName(msg), "GridWndProc", (long long)msg);
+    WatchdogDispatch dispatch(msg, traceMsgName(msg), "GridWndProc");
+    switch (msg) {
+    case WM_PAINT: {
+        PAINTSTRUCT ps;
+        HDC hdc = BeginPaint(hwnd, &ps);
+        paintGrid(hwnd, hdc);
+        EndPaint(hwnd, &ps);
+        break;
+    }
+
+    case WM_ERASEBKGND:
+        return 1; // paintGrid covers everything
+
+    case WM_SIZE: {
+        RECT rc;
+        GetClientRect(hwnd, &rc);
+        layoutForWidth(g_grid, rc.right);
+        updateGrid();
+        break;
+    }
 
+    case WM_VSCROLL: {
+        SCROLLINFO si{};
+        si.cbSize = sizeof(si);
+        si.fMask = SIF_ALL;
+        GetScrollInfo(hwnd, SB_VERT, &si);
+        int y = g_scrollY;
+        int line = g_grid.cardH + g_grid.margin;
+        switch (LOWORD(wParam)) {
+        case SB_LINEUP: y -= line; break;
+        case SB_LINEDOWN: y += line; break;
+        case SB_PAGEUP: y -= (int)si.nPage; break;
+        case SB_PAGEDOWN: y += (int)si.nPage; break;
+        case SB_THUMBTRACK:
+        case SB_THUMBPOSITION: y = si.nTrackPos; break;
+        case SB_TOP: y = 0; break;
+        case SB_BOTTOM: y = si.nMax; break;
+        }
+        scrollGridTo(y);
+        break;
+    }
+
+    case WM_MOUSEWHEEL: {
+        int delta = GET_WHEEL_DELTA_WPARAM(wParam);
+        scrollGridTo(g_scrollY - delta * (g_grid.cardH + g_grid.margin) / WHEEL_DELTA);
+        break;
+    }
+
+    case WM_LBUTTONDOWN: {
+        // find which card was clicked (mouse point relative to the grid's viewport)
+        int x = GET_X_LPARAM(lParam);
+        int y = GET_Y_LPARAM(lParam) + g_scrollY;
+        long index = cardAt(g_grid, g_notes.size(), x, y);
+        if (index >= 0) openNoteEditor(hMainWnd, g_notes[(size_t)index].id);
+        break;
+    }
+
+    default:
+        return DefWindowProc(hwnd, msg, wParam, lParam);
+    }
+    return 0;
 }
 
 // ---------------- Note editor window ----------------
+// one per editor window (GWLP_USERDATA): several can be open at once, and a
+// load answered by the worker has to land in the window that asked for it
+struct NoteEditor {
+    HWND hTitleEdit = NULL;
+    HWND hContentEdit = NULL;
+    intptr_t noteId = 0; // 0 => new note
+};
+
 LRESULT CALLBACK NoteWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
-    static HWND hTitleEdit = NULL;
-    static HWND hContentEdit = NULL;
-    static intptr_t noteId = 0; // 0 => new note
+    TRACE_SCOPE_DETAIL(traceMsgName(msg), "NoteWndProc", (long long)msg);
+    WatchdogDispatch dispatch(msg, traceMsgName(msg), "NoteWndProc");
+    NoteEditor* ed = (NoteEditor*)GetWindowLongPtr(hwnd, GWLP_USERDATA);
 
     switch (msg) {
     case WM_CREATE: {
         CREATESTRUCT* cs = (CREATESTRUCT*)lParam;
-        noteId = (intptr_t)cs->lpCreateParams;
+        ed = new NoteEditor();
+        ed->noteId = (intptr_t)cs->lpCreateParams;
+        SetWindowLongPtr(hwnd, GWLP_USERDATA, (LONG_PTR)ed);
 
         CreateWindowA("STATIC", "Judul:", WS_CHILD | WS_VISIBLE, 10, 10, 50, 20, hwnd, NULL, GetModuleHandle(NULL), NULL);
-        hTitleEdit = CreateWindowExA(WS_EX_CLIENTEDGE, "EDIT", "", WS_CHILD | WS_VISIBLE | ES_AUTOHSCROLL,
+        ed->hTitleEdit = CreateWindowExW(WS_EX_CLIENTEDGE, L"EDIT", L"", WS_CHILD | WS_VISIBLE | ES_AUTOHSCROLL,
             70, 10, 320, 22, hwnd, NULL, GetModuleHandle(NULL), NULL);
 
         CreateWindowA("STATIC", "Isi Catatan:", WS_CHILD | WS_VISIBLE, 10, 40, 80, 20, hwnd, NULL, GetModuleHandle(NULL), NULL);
-        hContentEdit = CreateWindowExA(WS_EX_CLIENTEDGE, "EDIT", "", WS_CHILD | WS_VISIBLE | ES_MULTILINE | ES_AUTOVSCROLL | WS_VSCROLL,
+        ed->hContentEdit = CreateWindowExW(WS_EX_CLIENTEDGE, L"EDIT", L"", WS_CHILD | WS_VISIBLE | ES_MULTILINE | ES_AUTOVSCROLL | WS_VSCROLL,
             10, 65, 380, 260, hwnd, NULL, GetModuleHandle(NULL), NULL);
 
-        // if editing existing note, load its content
-        if (noteId > 0 && db) {
-            const char* sql = "SELECT title, content FROM notes WHERE id = ? LIMIT 1;";
-            sqlite3_stmt* stmt = nullptr;
-            if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) == SQLITE_OK) {
-                sqlite3_bind_int(stmt, 1, (int)noteId);
-                if (sqlite3_step(stmt) == SQLITE_ROW) {
-                    const unsigned char* t = sqlite3_column_text(stmt, 0);
-                    const unsigned char* c = sqlite3_column_text(stmt, 1);
-                    if (t) SetWindowTextA(hTitleEdit, (const char*)t);
-                    if (c) SetWindowTextA(hContentEdit, (const char*)c);
-                }
-            }
-            sqlite3_finalize(stmt);
+        // if editing existing note, load its content (arrives as MSG_DB_RESULT)
+        if (ed->noteId > 0) submitLoad((int)ed->noteId, hwnd);
+        break;
+    }
+
+    case MSG_DB_RESULT: {
+        DbResult* r = (DbResult*)lParam;
+        if (ed && r->op == DbOp::Load && r->ok && !r->notes.empty()) {
+            SetWindowTextW(ed->hTitleEdit, toWide(r->notes[0].title).c_str());
+            SetWindowTextW(ed->hContentEdit, toWide(r->notes[0].content).c_str());
         }
+        delete r;
         break;
     }
 
     case WM_CLOSE: {
         // save note (insert or update)
-        int lenTitle = GetWindowTextLengthA(hTitleEdit);
-        int lenContent = GetWindowTextLengthA(hContentEdit);
-        std::string title; title.resize(lenTitle);
-        std::string content; content.resize(lenContent);
-        GetWindowTextA(hTitleEdit, &title[0], lenTitle + 1);
-        GetWindowTextA(hContentEdit, &content[0], lenContent + 1);
+        if (!ed) {
+            DestroyWindow(hwnd);
+            break;
+        }
+        std::string title = windowTextUtf8(ed->hTitleEdit);
+        std::string content = windowTextUtf8(ed->hContentEdit);
 
         // trim maybe
+        // queued on the worker (returns at once); it commits saves in batches and
+        // answers the main window, which then patches the list
         bool hasContent = !content.empty();
         if (hasContent) {
-            if (noteId > 0) {
-                updateNotePrepared((int)noteId, title, content);
-            } else {
-                insertNotePrepared(title, content);
-            }
+            submitSave((int)ed->noteId, title, content, hMainWnd);
         }
-        // ask main to refresh
-        if (hMainWnd) PostMessage(hMainWnd, MSG_REFRESH, 0, 0);
         DestroyWindow(hwnd);
         break;
     }
 
+    case WM_NCDESTROY:
+        SetWindowLongPtr(hwnd, GWLP_USERDATA, 0);
+        delete ed;
+        return DefWindowProc(hwnd, msg, wParam, lParam);
+
     case WM_SIZE: {
         InvalidateRect(hwnd, NULL, TRUE);
 
@@ -286,33 +435,56 @@ LRESULT CALLBACK NoteWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 
 // ---------------- main window proc ----------------
 LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+    TRACE_SCOPE_DETAIL(traceMsgName(msg), "WndProc", (long long)msg);
+    WatchdogDispatch dispatch(msg, traceMsgName(msg), "WndProc");
     switch (msg) {
     case WM_CREATE: {
         hMainWnd = hwnd;
         // fonts
         hFontBold = CreateFontA(16, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE,
-            ANSI_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
+            DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
             DEFAULT_QUALITY, DEFAULT_PITCH | FF_DONTCARE, "Segoe UI");
         hFontNormal = CreateFontA(14, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
-            ANSI_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
+            DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
             DEFAULT_QUALITY, DEFAULT_PITCH | FF_DONTCARE, "Segoe UI");
 
-        // init DB
-        if (!initDatabase()) {
+        // init DB (the worker thread owns the connection from here on)
+        std::string err;
+        if (!startDbWorker("notes.db", onDbResult, err)) {
+            WatchdogWait wait;
+            MessageBoxW(NULL, toWide(err).c_str(), L"DB Error", MB_OK | MB_ICONERROR);
             PostQuitMessage(1);
             break;
         }
 
         // create search box (only once)
-        hSearchBox = CreateWindowExA(WS_EX_CLIENTEDGE, "EDIT", "",
+        hSearchBox = CreateWindowExW(WS_EX_CLIENTEDGE, L"EDIT", L"",
             WS_CHILD | WS_VISIBLE | ES_AUTOHSCROLL, 10, 10, 360, 24, hwnd, (HMENU)ID_SEARCH, GetModuleHandle(NULL), NULL);
 
+        // card grid fills the rest of the window
+        {
+            WNDCLASSEX wcGrid{};
+            wcGrid.cbSize = sizeof(wcGrid);
+            wcGrid.style = CS_HREDRAW | CS_VREDRAW;
+            wcGrid.lpfnWndProc = GridWndProc;
+            wcGrid.hInstance = GetModuleHandle(NULL);
+            wcGrid.hCursor = LoadCursor(NULL, IDC_ARROW);
+            wcGrid.lpszClassName = g_szGridClass;
+            RegisterClassExA(&wcGrid);
+
+            RECT rc;
+            GetClientRect(hwnd, &rc);
+            hGrid = CreateWindowExA(0, g_szGridClass, "", WS_CHILD | WS_VISIBLE | WS_VSCROLL | WS_CLIPSIBLINGS,
+                0, GRID_TOP, rc.right, rc.bottom - GRID_TOP, hwnd, NULL, GetModuleHandle(NULL), NULL);
+        }
+
         // create add button once
         hButtonAdd = CreateWindowA("BUTTON", "+", WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
             310, 300, 60, 60, hwnd, (HMENU)ID_BTN_ADD, GetModuleHandle(NULL), NULL);
+        placeAddButton();
 
         // initial show notes
-        showNotes(hwnd, "");
+        requestNotes();
         break;
     }
 
@@ -321,65 +493,49 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         int code = HIWORD(wParam);
         if (id == ID_BTN_ADD) {
             // open new note window (noteId = 0)
-            WNDCLASSEX wcNote{};
-            wcNote.cbSize = sizeof(wcNote);
-            wcNote.lpfnWndProc = NoteWndProc;
-            wcNote.hInstance = GetModuleHandle(NULL);
-            wcNote.lpszClassName = "NoteWindowClass";
-            RegisterClassExA(&wcNote);
-
-            HWND note = CreateWindowExA(0, "NoteWindowClass", "Catatan Baru",
-                WS_OVERLAPPEDWINDOW, CW_USEDEFAULT, CW_USEDEFAULT, 420, 380,
-                hwnd, NULL, GetModuleHandle(NULL), (LPVOID)0);
-            ShowWindow(note, SW_SHOW);
+            openNoteEditor(hwnd, 0);
         } else if (id == ID_SEARCH && code == EN_CHANGE) {
-            // search changed -> refresh
-            char q[256] = {0};
-            GetWindowTextA(hSearchBox, q, sizeof(q));
-            showNotes(hwnd, std::string(q));
+            // search changed -> refresh (older searches still running get cancelled)
+            requestNotes();
         } else {
             // other command ids (none currently)
         }
         break;
     }
 
-    case WM_LBUTTONDOWN: {
-        // find which card was clicked (mouse point relative to client)
-        POINT pt;
-        pt.x = LOWORD(lParam);
-        pt.y = HIWORD(lParam);
-        for (auto &ci : g_cards) {
-            if (pt.x >= ci.rc.left && pt.x <= ci.rc.right && pt.y >= ci.rc.top && pt.y <= ci.rc.bottom) {
-                // open editor for this note id
-                intptr_t nid = ci.noteId;
-                WNDCLASSEX wcNote{};
-                wcNote.cbSize = sizeof(wcNote);
-                wcNote.lpfnWndProc = NoteWndProc;
-                wcNote.hInstance = GetModuleHandle(NULL);
-                wcNote.lpszClassName = "NoteWindowClass";
-                RegisterClassExA(&wcNote);
-
-                HWND note = CreateWindowExA(0, "NoteWindowClass", "Edit Catatan",
-                    WS_OVERLAPPEDWINDOW, CW_USEDEFAULT, CW_USEDEFAULT, 420, 380,
-                    hwnd, NULL, GetModuleHandle(NULL), (LPVOID)nid);
-                ShowWindow(note, SW_SHOW);
-                break;
-            }
-        }
-        break;
-    }
-
     case MSG_REFRESH:
         // refresh list (preserve current search text)
-        {
-            char q[256] = {0};
-            if (hSearchBox) GetWindowTextA(hSearchBox, q, sizeof(q));
-            showNotes(hwnd, std::string(q));
+        requestNotes();
+        break;
+
+    case MSG_DB_RESULT: {
+        DbResult* r = (DbResult*)lParam;
+        if (r->op == DbOp::Search) {
+            // only the answer to the latest keystroke is drawn
+            if (r->seq == latestSearchSeq()) showNotes(r);
+        } else if (r->op == DbOp::Page) {
+            appendNotes(r);
+        } else if (r->op == DbOp::Save) {
+            if (r->fullRefresh) PostMessage(hwnd, MSG_REFRESH, 0, 0);
+            else applyNoteChanges(r->changes);
         }
+        delete r;
         break;
+    }
+
+    // Windows' own loops while the window is dragged/sized or a menu is open:
+    // the handler that started them waits on the user, it is not stalled
+    case WM_ENTERSIZEMOVE:
+    case WM_ENTERMENULOOP:
+        watchdogModalLoop(true);
+        return DefWindowProc(hwnd, msg, wParam, lParam);
+    case WM_EXITSIZEMOVE:
+    case WM_EXITMENULOOP:
+        watchdogModalLoop(false);
+        return DefWindowProc(hwnd, msg, wParam, lParam);
 
     case WM_DESTROY:
-        if (db) sqlite3_close(db);
+        stopDbWorker(); // commits queued saves with a full fsync
         if (hFontBold) DeleteObject(hFontBold);
         if (hFontNormal) DeleteObject(hFontNormal);
         PostQuitMessage(0);
@@ -393,6 +549,21 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
 
 // ---------------- winmain ----------------
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
+    // --slow-ms=N: statements slower than N ms go to notes.db-slow.log
+    if (const char* slow = strstr(lpCmdLine, "--slow-ms=")) {
+        SlowLogOptions o;
+        o.thresholdMs = atoi(slow + 10);
+        enableSlowQueryLog(o);
+    }
+    // --resident: keep every note in memory, the list and LIKE search skip SQLite
+    if (strstr(lpCmdLine, "--resident")) enableResidentCorpus(ResidentOptions());
+    // --trace-events=N: spans kept per thread (NOTES_TRACE builds)
+    if (const char* events = strstr(lpCmdLine, "--trace-events=")) setTraceRingEvents((size_t)atoi(events + 15));
+    // handlers that keep the UI thread longer than this (--stall-ms=N, 0 = off)
+    // are summed up in notes-stalls.txt
+    int stallMs = STALL_MS;
+    if (const char* stall = strstr(lpCmdLine, "--stall-ms=")) stallMs = atoi(stall + 11);
+
     WNDCLASSEX wc{};
     wc.cbSize = sizeof(WNDCLASSEX);
     wc.lpfnWndProc = WndProc;
@@ -407,6 +578,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         MessageBoxA(NULL, "Register class failed", "Error", MB_OK | MB_ICONERROR);
         return 1;
     }
+    startWatchdog(stallMs, "notes-stalls.txt");
 
     // mengatur tampilan window
     HWND hwnd = CreateWindowExA(
@@ -429,10 +601,22 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     ShowWindow(hwnd, nCmdShow);
     UpdateWindow(hwnd);
 
+    TRACE_THREAD_NAME("ui");
     MSG msg;
-    while (GetMessage(&msg, NULL, 0, 0) > 0) {
+    // W: typed characters reach the (Unicode) edit controls without an ANSI detour
+    while (GetMessageW(&msg, NULL, 0, 0) > 0) {
+#ifdef NOTES_TRACE
+        // Ctrl+Shift+T: dump the spans so far to notes-trace.json (chrome://tracing)
+        if (msg.message == WM_KEYDOWN && msg.wParam == 'T' && GetKeyState(VK_CONTROL) < 0 && GetKeyState(VK_SHIFT) < 0) {
+            std::string err;
+            if (writeTrace("notes-trace.json", err)) MessageBeep(MB_OK);
+            else MessageBoxW(hwnd, toWide(err).c_str(), L"Trace", MB_OK | MB_ICONERROR);
+            continue;
+        }
+#endif
         TranslateMessage(&msg);
-        DispatchMessage(&msg);
+        DispatchMessageW(&msg);
     }
+    stopWatchdog();
     return (int)msg.wParam;
 }
@@ -0,0 +1,400 @@
+// notes_bench.cpp
+// headless driver: jalanin workload yang sama dengan WndProc / NoteWndProc
+// tanpa window, supaya bisa di-profile di Linux.
+//
+//   notes_bench [--db=bench_notes.db] [--notes=2000] [--updates=500] [--query=catatan]
+//               [--profile=balanced] [--commits=300] [--bulk=100000] [--import-files=5000]
+#include "notes_export.h"
+#include "notes_import.h"
+#include "notes_layout.h"
+#include "notes_metrics.h"
+#include "notes_search.h"
+#include "notes_worker.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ---------------- small helpers ----------------
+typedef std::chrono::steady_clock Clock;
+
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+static void report(const char* name, int count, double ms) {
+    double avgUs = count > 0 ? ms * 1000.0 / count : 0.0;
+    std::printf("%-22s %8d ops %10.2f ms %10.2f us/op\n", name, count, ms, avgUs);
+}
+
+// deterministic text so runs are comparable
+static unsigned int g_seed = 12345;
+static unsigned int nextRand() {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return (g_seed >> 16) & 0x7fff;
+}
+
+static const char* kWords[] = {
+    "catatan", "belanja", "rapat", "kerja", "ide", "proyek", "jadwal", "besok",
+    "meeting", "todo", "shopping", "draft", "notes", "review", "budget", "travel",
+};
+
+static std::string makeText(int words) {
+    std::string s;
+    for (int i = 0; i < words; i++) {
+        if (i) s += ' ';
+        s += kWords[nextRand() % (sizeof(kWords) / sizeof(kWords[0]))];
+    }
+    return s;
+}
+
+static const char* argValue(int argc, char** argv, const char* name, const char* def) {
+    size_t len = std::strlen(name);
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], name, len) == 0 && argv[i][len] == '=') return argv[i] + len + 1;
+    }
+    return def;
+}
+
+// a WAL database is up to three files
+static void removeDb(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-wal").c_str());
+    std::remove((path + "-shm").c_str());
+    std::remove((path + "-journal").c_str());
+}
+
+static std::atomic<int> g_delivered(0);
+static std::atomic<uint64_t> g_lastDelivered(0);
+
+static void onBenchResult(DbResult* r) {
+    g_delivered++;
+    g_lastDelivered = r->seq;
+    delete r;
+}
+
+// ---------------- main ----------------
+int main(int argc, char** argv) {
+    const char* path = argValue(argc, argv, "--db", "bench_notes.db");
+    int noteCount = std::atoi(argValue(argc, argv, "--notes", "2000"));
+    int updateCount = std::atoi(argValue(argc, argv, "--updates", "500"));
+    std::string query = argValue(argc, argv, "--query", "catatan");
+    int commitCount = std::atoi(argValue(argc, argv, "--commits", "300"));
+    int bulkCount = std::atoi(argValue(argc, argv, "--bulk", "100000"));
+    int importFiles = std::atoi(argValue(argc, argv, "--import-files", "5000"));
+    DbProfile profile = DbProfile::Balanced;
+    if (!profileFromName(argValue(argc, argv, "--profile", "balanced"), profile)) {
+        std::fprintf(stderr, "unknown profile (durable, balanced, throughput)\n");
+        return 1;
+    }
+    setDbProfile(profile);
+
+    removeDb(path);
+    if (!initDatabase(path)) {
+        std::fprintf(stderr, "initDatabase failed: %s\n", lastDbError().c_str());
+        return 1;
+    }
+
+    // NoteWndProc WM_CLOSE with noteId == 0
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < noteCount; i++) {
+        if (!insertNotePrepared(makeText(3), makeText(40 + (int)(nextRand() % 200)))) {
+            std::fprintf(stderr, "insert failed: %s\n", sqlite3_errmsg(db));
+            return 1;
+        }
+    }
+    report("insert (new note)", noteCount, msSince(t0));
+
+    // NoteWndProc WM_CLOSE with noteId > 0
+    t0 = Clock::now();
+    for (int i = 0; i < updateCount; i++) {
+        int id = 1 + (int)(nextRand() % (noteCount > 0 ? noteCount : 1));
+        updateNotePrepared(id, makeText(3), makeText(40 + (int)(nextRand() % 200)));
+    }
+    report("update (edit note)", updateCount, msSince(t0));
+
+    // NoteWndProc WM_CREATE loading an existing note
+    t0 = Clock::now();
+    Note n;
+    int loaded = 0;
+    for (int i = 0; i < updateCount; i++) {
+        if (loadNote(1 + (int)(nextRand() % (noteCount > 0 ? noteCount : 1)), n)) loaded++;
+    }
+    report("load (open editor)", loaded, msSince(t0));
+
+    // WndProc EN_CHANGE: one fetchNotes per typed character, for every search mode
+    static const struct { SearchMode mode; const char* name; } kModes[] = {
+        { SearchMode::Like, "search like" },
+        { SearchMode::Substring, "search substring" },
+        { SearchMode::Prefix, "search prefix" },
+        { SearchMode::Ranked, "search ranked" },
+    };
+    waitForSearchIndex();
+    size_t rows = 0;
+    for (auto& m : kModes) {
+        setSearchMode(m.mode);
+        size_t modeRows = 0;
+        t0 = Clock::now();
+        for (size_t i = 1; i <= query.size(); i++) {
+            modeRows += fetchNotes(query.substr(0, i)).size();
+        }
+        report(m.name, (int)query.size(), msSince(t0));
+        rows += modeRows;
+    }
+    setSearchMode(SearchMode::Substring);
+
+    // the same keystrokes through a SearchSession (what the db worker uses)
+    SearchSession session;
+    NotePage found;
+    t0 = Clock::now();
+    for (size_t i = 1; i <= query.size(); i++) {
+        session.search(query.substr(0, i), FIRST_PAGE_ROWS, found);
+        rows += found.notes.size();
+    }
+    report("search session (page)", (int)query.size(), msSince(t0));
+    std::printf("session: %lld sql queries, %lld refined in memory\n",
+        session.stats().sqlQueries, session.stats().memoryRefines);
+
+    // WndProc MSG_REFRESH: empty search shows everything
+    t0 = Clock::now();
+    const int refreshCount = 20;
+    for (int i = 0; i < refreshCount; i++) rows += fetchNotes("").size();
+    report("refresh (full list)", refreshCount, msSince(t0));
+
+    // the same list as the grid gets it now: first page, then pages to the end
+    t0 = Clock::now();
+    for (int i = 0; i < refreshCount; i++) {
+        fetchNotePage("", 0, FIRST_PAGE_ROWS, found);
+        rows += found.notes.size();
+    }
+    report("first page (paint)", refreshCount, msSince(t0));
+    t0 = Clock::now();
+    int pages = 0;
+    for (int before = 0;; pages++) {
+        fetchNotePage("", before, PAGE_ROWS, found);
+        rows += found.notes.size();
+        before = found.nextBefore;
+        if (!found.more) break;
+    }
+    report("scroll pages to end", pages + 1, msSince(t0));
+
+    // grid paint/scroll: work per frame is the visible range, whatever the list size
+    GridLayout grid;
+    layoutForWidth(grid, 434);
+    const size_t gridCount = 1000000;
+    const int viewH = 540;
+    const int frames = 100000;
+    size_t drawn = 0;
+    t0 = Clock::now();
+    for (int i = 0; i < frames; i++) {
+        int y = clampScroll(grid, gridCount, (int)((long long)i * 997 % contentHeight(grid, gridCount)), viewH);
+        size_t first, last;
+        visibleRange(grid, gridCount, y, viewH, &first, &last);
+        drawn += last - first;
+        if (cardAt(grid, gridCount, 50, y + 100) >= 0) drawn++;
+    }
+    report("grid frame (1M cards)", frames, msSince(t0));
+    std::printf("cards per frame: %.1f\n", (double)drawn / frames);
+
+    std::printf("rows fetched: %zu\n", rows);
+    StmtCacheStats sc = stmtCacheStats();
+    std::printf("stmt cache: %lld hits, %lld misses, %d statements\n", sc.hits, sc.misses, sc.size);
+    // the statements that did the most work: full scans first, then VM steps
+    sampleDbMetrics();
+    DbMetrics dm = dbMetrics();
+    std::printf("sqlite: %.1f MB heap, page cache %lld hits / %lld misses, %lld full-scan steps\n",
+        dm.memoryUsed / 1048576.0, dm.cacheHits, dm.cacheMisses, dm.fullscanSteps);
+    for (size_t i = 0; i < dm.statements.size() && i < 3; i++) {
+        const StmtMetrics& st = dm.statements[i];
+        std::printf("  %9lld full-scan, %11lld vm steps, %6lld runs: %.60s\n", st.fullscanSteps, st.vmSteps, st.runs,
+            st.sql.c_str());
+    }
+    closeDatabase();
+
+    // same typing, but through the db worker the way WndProc does it now:
+    // submit time is what the message loop pays, delivery is when cards can be drawn
+    std::string err;
+    if (!startDbWorker(path, onBenchResult, err)) {
+        std::fprintf(stderr, "startDbWorker failed: %s\n", err.c_str());
+        return 1;
+    }
+    t0 = Clock::now();
+    uint64_t last = 0;
+    for (size_t i = 1; i <= query.size(); i++) last = submitSearch(query.substr(0, i), nullptr);
+    report("async submit (ui)", (int)query.size(), msSince(t0));
+    while (g_lastDelivered.load() != last) std::this_thread::yield();
+    report("async latest result", 1, msSince(t0));
+    std::printf("async results delivered: %d of %zu (stale ones dropped)\n", g_delivered.load(), query.size());
+
+    // backspace the query away and type it again, waiting for every answer:
+    // the second pass is served by the worker's result cache
+    t0 = Clock::now();
+    int typed = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = query.size(); i >= 1; i--) {
+            last = submitSearch(query.substr(0, i), nullptr);
+            while (g_lastDelivered.load() != last) std::this_thread::yield();
+            typed++;
+        }
+    }
+    report("async backspace x2", typed, msSince(t0));
+    SearchCacheStats cs = searchCacheStats();
+    std::printf("result cache: %lld hits, %lld misses, %.0f%% hit rate, %d entries, %zu bytes\n",
+        cs.hits, cs.misses, cs.hitRate() * 100.0, cs.entries, cs.bytes);
+
+    // NoteWndProc WM_CLOSE through the worker: submitSave only queues the text,
+    // the worker commits a batch per transaction. half the saves are re-saves
+    // of a few open notes, which coalesce while queued.
+    std::vector<std::string> titles, texts;
+    for (int i = 0; i < updateCount; i++) {
+        titles.push_back(makeText(3));
+        texts.push_back(makeText(40 + (int)(nextRand() % 200)));
+    }
+    t0 = Clock::now();
+    for (int i = 0; i < updateCount; i++) {
+        int id = (i % 2) ? 1 + (int)(nextRand() % 20) : 0;
+        submitSave(id, titles[i], texts[i], nullptr);
+    }
+    report("async save (ui)", updateCount, msSince(t0));
+    t0 = Clock::now();
+    stopDbWorker();
+    report("save flush + close", 1, msSince(t0));
+    SaveQueueStats sq = saveQueueStats();
+    std::printf("save queue: %lld saves, %lld coalesced, %lld rows in %lld transactions\n",
+        sq.queued, sq.coalesced, sq.written, sq.batches);
+
+    // durability vs throughput: the same saves, one commit each, under every
+    // profile on a fresh file; then the list read back from a cold connection
+    std::string profilePath = std::string(path) + ".profile";
+    for (DbProfile p : { DbProfile::Durable, DbProfile::Balanced, DbProfile::Throughput }) {
+        removeDb(profilePath);
+        setDbProfile(p);
+        if (!initDatabase(profilePath.c_str())) {
+            std::fprintf(stderr, "initDatabase failed: %s\n", lastDbError().c_str());
+            return 1;
+        }
+        std::string name = std::string("commit ") + profileName(p);
+        t0 = Clock::now();
+        for (int i = 0; i < commitCount; i++) insertNotePrepared(makeText(3), makeText(40 + (int)(nextRand() % 200)));
+        for (int i = 0; i < commitCount; i++) {
+            updateNotePrepared(1 + (int)(nextRand() % (commitCount > 0 ? commitCount : 1)), makeText(3), makeText(60));
+        }
+        report(name.c_str(), commitCount * 2, msSince(t0));
+        closeDatabase();
+
+        initDatabase(profilePath.c_str());
+        name = std::string("list ") + profileName(p);
+        t0 = Clock::now();
+        for (int i = 0; i < refreshCount; i++) fetchNotes("");
+        report(name.c_str(), refreshCount, msSince(t0));
+        closeDatabase();
+    }
+
+    // scripted/migration writes: insertNotes/updateNotes, one transaction per call
+    removeDb(profilePath);
+    setDbProfile(DbProfile::Throughput);
+    if (!initDatabase(profilePath.c_str())) {
+        std::fprintf(stderr, "initDatabase failed: %s\n", lastDbError().c_str());
+        return 1;
+    }
+    std::vector<Note> bulk(bulkCount);
+    for (int i = 0; i < bulkCount; i++) {
+        bulk[i].id = 0;
+        bulk[i].title = makeText(3);
+        bulk[i].content = makeText(10 + (int)(nextRand() % 30));
+    }
+    std::vector<NoteWriteResult> written;
+    const int bulkBatch = 10000;
+    int bulkOk = 0;
+    t0 = Clock::now();
+    for (int i = 0; i < bulkCount; i += bulkBatch) {
+        insertNotes(bulk.data() + i, (size_t)std::min(bulkBatch, bulkCount - i), written);
+        for (size_t k = 0; k < written.size(); k++) {
+            if (!written[k].ok) continue;
+            bulk[i + k].id = written[k].id;
+            bulkOk++;
+        }
+    }
+    double ms = msSince(t0);
+    report("bulk insert", bulkOk, ms);
+    std::printf("bulk insert: %.0f rows/sec\n", ms > 0 ? bulkOk * 1000.0 / ms : 0.0);
+    t0 = Clock::now();
+    waitForSearchIndex();
+    report("index catch-up", bulkOk, msSince(t0));
+    // updates keep the FTS triggers (the old text has to leave the index), one batch is enough
+    int updateRows = std::min(bulkCount, bulkBatch);
+    for (int i = 0; i < updateRows; i++) bulk[i].content = makeText(10 + (int)(nextRand() % 30));
+    bulkOk = 0;
+    t0 = Clock::now();
+    updateNotes(bulk.data(), (size_t)updateRows, written);
+    for (auto& w : written) bulkOk += w.ok ? 1 : 0;
+    ms = msSince(t0);
+    report("bulk update", bulkOk, ms);
+    std::printf("bulk update: %.0f rows/sec\n", ms > 0 ? bulkOk * 1000.0 / ms : 0.0);
+    closeDatabase();
+
+    // migrating a folder of text files: a tree of .txt/.md files, a few big
+    // enough to be memory-mapped, through importDirectory
+    std::string importDir = std::string(path) + ".import";
+    std::error_code ec;
+    std::filesystem::remove_all(importDir, ec);
+    for (int i = 0; i < importFiles; i++) {
+        std::string sub = importDir + "/folder" + std::to_string(i % 16);
+        if (i < 16) std::filesystem::create_directories(sub, ec);
+        std::string file = sub + "/note" + std::to_string(i) + ((i % 2) ? ".md" : ".txt");
+        FILE* f = std::fopen(file.c_str(), "wb");
+        if (!f) continue;
+        std::string text = (i % 2) ? "# " + makeText(3) + "\n\n" : makeText(3) + "\n";
+        int words = (i % 500 == 0) ? 60000 : 20 + (int)(nextRand() % 200);
+        text += makeText(words) + "\n";
+        std::fwrite(text.data(), 1, text.size(), f);
+        std::fclose(f);
+    }
+    removeDb(profilePath);
+    if (!initDatabase(profilePath.c_str())) {
+        std::fprintf(stderr, "initDatabase failed: %s\n", lastDbError().c_str());
+        return 1;
+    }
+    ImportOptions io;
+    io.title = ImportTitle::FirstLine;
+    ImportProgress ip;
+    t0 = Clock::now();
+    if (!importDirectory(importDir, io, ip, err)) std::fprintf(stderr, "import failed: %s\n", err.c_str());
+    ms = msSince(t0);
+    report("import directory", (int)ip.imported, ms);
+    std::printf("import: %zu files, %zu failed, %.1f MB, %.0f files/sec\n", ip.filesTotal, ip.failed,
+        ip.bytes / 1048576.0, ms > 0 ? ip.imported * 1000.0 / ms : 0.0);
+
+    // and back out again, streamed: JSONL, then one file per note
+    std::string exportPath = std::string(path) + ".export";
+    ExportOptions eo;
+    ExportProgress ep;
+    t0 = Clock::now();
+    if (!exportJsonl(exportPath + ".jsonl", eo, ep, err)) std::fprintf(stderr, "export failed: %s\n", err.c_str());
+    ms = msSince(t0);
+    report("export jsonl", (int)ep.notes, ms);
+    std::printf("export jsonl: %.1f MB, %.0f MB/sec\n", ep.bytes / 1048576.0, ms > 0 ? ep.bytes / 1048576.0 * 1000.0 / ms : 0.0);
+    t0 = Clock::now();
+    if (!exportFiles(exportPath, eo, ep, err)) std::fprintf(stderr, "export failed: %s\n", err.c_str());
+    ms = msSince(t0);
+    report("export files", (int)ep.notes, ms);
+    std::printf("export files: %zu files, %zu failed, %.0f files/sec\n", ep.notes, ep.failed,
+        ms > 0 ? ep.notes * 1000.0 / ms : 0.0);
+    closeDatabase();
+    std::filesystem::remove_all(importDir, ec);
+    std::filesystem::remove_all(exportPath, ec);
+    std::remove((exportPath + ".jsonl").c_str());
+
+    removeDb(profilePath);
+    setDbProfile(profile);
+    CheckpointStats cp = checkpointStats();
+    std::printf("checkpoints: %lld runs, %lld busy, %lld restarts, %lld pages copied (off the commit path)\n",
+        cp.runs, cp.busy, cp.restarts, cp.pagesCopied);
+    return 0;
+}
@@ -0,0 +1,92 @@
+// notes_cache.cpp
+#include "notes_cache.h"
+#include "notes_internal.h"
+#include "notes_simd.h"
+
+std::string normalizeQuery(const std::string& q, SearchMode mode) {
+    std::string key;
+    key.reserve(q.size() + 2);
+    key += (char)('0' + (int)mode);
+    key += ':';
+    if (mode == SearchMode::Like && likeWildcards(q)) {
+        // the typed wildcards apart from a % or _ that only folding made
+        key += likePattern(q);
+        return key;
+    }
+    if (mode == SearchMode::Like || mode == SearchMode::Substring) {
+        key[1] = '=';
+        foldText(q.data(), q.size(), key);
+        return key;
+    }
+    for (char c : q) key += (c >= 'A' && c <= 'Z') ? (char)(c + 32) : c;
+    return key;
+}
+
+static size_t entryBytes(const std::string& key, const std::vector<Note>& notes) {
+    size_t bytes = sizeof(std::string) * 2 + key.capacity() + notes.capacity() * sizeof(Note);
+    for (auto& n : notes) bytes += n.title.capacity() + n.content.capacity();
+    return bytes;
+}
+
+SearchResultCache::SearchResultCache(size_t maxEntries, size_t maxBytes)
+    : maxEntries_(maxEntries), maxBytes_(maxBytes) {
+    stats_ = SearchCacheStats{ 0, 0, 0, 0, 0 };
+}
+
+bool SearchResultCache::get(const std::string& q, SearchMode mode, uint64_t generation, NotePage& out) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = index_.find(normalizeQuery(q, mode));
+    if (it == index_.end()) {
+        stats_.misses++;
+        return false;
+    }
+    if (it->second->generation != generation) {
+        eraseLocked(it->second);
+        stats_.staleDrops++;
+        stats_.misses++;
+        return false;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    out = it->second->page;
+    stats_.hits++;
+    return true;
+}
+
+void SearchResultCache::put(const std::string& q, SearchMode mode, uint64_t generation, const NotePage& page) {
+    std::lock_guard<std::mutex> guard(lock_);
+    std::string key = normalizeQuery(q, mode);
+    auto it = index_.find(key);
+    if (it != index_.end()) eraseLocked(it->second);
+
+    size_t bytes = entryBytes(key, page.notes);
+    if (bytes > maxBytes_ || maxEntries_ == 0) return; // would evict everything else
+
+    lru_.push_front(Entry{ key, generation, page, bytes });
+    index_[key] = lru_.begin();
+    stats_.bytes += bytes;
+    stats_.entries++;
+
+    while (!lru_.empty() && ((size_t)stats_.entries > maxEntries_ || stats_.bytes > maxBytes_)) {
+        eraseLocked(std::prev(lru_.end()));
+    }
+}
+
+void SearchResultCache::eraseLocked(EntryList::iterator it) {
+    stats_.bytes -= it->bytes;
+    stats_.entries--;
+    index_.erase(it->key);
+    lru_.erase(it);
+}
+
+void SearchResultCache::clear() {
+    std::lock_guard<std::mutex> guard(lock_);
+    lru_.clear();
+    index_.clear();
+    stats_.entries = 0;
+    stats_.bytes = 0;
+}
+
+SearchCacheStats SearchResultCache::stats() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return stats_;
+}
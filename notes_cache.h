@@ -0,0 +1,54 @@
+// notes_cache.h
+// bounded LRU of first result pages (ids, titles, previews) keyed by normalized
+// query. every entry remembers writeGeneration() at the time it was filled and
+// is dropped on lookup once a write has happened since.
+#pragma once
+#include "notes_db.h"
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct SearchCacheStats {
+    long long hits;
+    long long misses;
+    long long staleDrops; // entries found but older than the last write
+    int entries;
+    size_t bytes;
+    double hitRate() const { return (hits + misses) ? (double)hits / (double)(hits + misses) : 0.0; }
+};
+
+class SearchResultCache {
+public:
+    SearchResultCache(size_t maxEntries = 64, size_t maxBytes = 32 * 1024 * 1024);
+
+    bool get(const std::string& q, SearchMode mode, uint64_t generation, NotePage& out);
+    // notes should already be previews (see makePreview), that is all the list shows
+    void put(const std::string& q, SearchMode mode, uint64_t generation, const NotePage& page);
+    void clear();
+    SearchCacheStats stats() const;
+
+private:
+    struct Entry {
+        std::string key;
+        uint64_t generation;
+        NotePage page;
+        size_t bytes;
+    };
+    typedef std::list<Entry> EntryList;
+
+    void eraseLocked(EntryList::iterator it);
+
+    mutable std::mutex lock_;
+    size_t maxEntries_;
+    size_t maxBytes_;
+    EntryList lru_; // front = most recently used
+    std::unordered_map<std::string, EntryList::iterator> index_;
+    SearchCacheStats stats_;
+};
+
+// the cache key: mode plus query with ASCII case folded, since every search
+// mode ignores ASCII case ("Cat" and "cat" give the same rows); Like and
+// Substring compare folded text, so their key is foldText(q) ("Café" = "CAFE")
+std::string normalizeQuery(const std::string& q, SearchMode mode);
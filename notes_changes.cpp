@@ -0,0 +1,83 @@
+// notes_changes.cpp
+#include "notes_changes.h"
+#include "notes_internal.h"
+#include <cstring>
+#include <unordered_map>
+
+// past this a full refresh is cheaper than patching row by row
+static const size_t kMaxPendingChanges = 1024;
+
+// rows written by the open transaction, and by committed ones not taken yet.
+// the transaction's rows only count once its COMMIT has returned SQLITE_OK
+// (noteChangesCommitted): the commit hook runs before the commit can still
+// fail and roll back
+static std::vector<NoteChange> g_txChanges;
+static bool g_txOverflow = false; // the transaction wrote more than kMaxPendingChanges rows
+static std::vector<NoteChange> g_committed;
+static std::unordered_map<int, size_t> g_committedIndex;
+static bool g_overflow = false;
+
+static void onUpdate(void*, int op, const char*, const char* table, sqlite3_int64 rowid) {
+    if (std::strcmp(table, "notes") != 0) return; // FTS shadow tables, notes_meta, ...
+    if (g_overflow || g_txOverflow) return;
+    if (g_txChanges.size() >= kMaxPendingChanges) {
+        // a big import: don't keep every id, the whole list is rebuilt anyway
+        g_txOverflow = true;
+        g_txChanges.clear();
+        return;
+    }
+    NoteChange c;
+    c.kind = op == SQLITE_INSERT ? ChangeKind::Inserted
+           : op == SQLITE_DELETE ? ChangeKind::Deleted : ChangeKind::Updated;
+    c.id = (int)rowid;
+    c.matches = false;
+    c.note.id = (int)rowid;
+    g_txChanges.push_back(c);
+}
+
+// merge what the transaction did into the committed set, one entry per id
+static void mergeChange(const NoteChange& c) {
+    auto it = g_committedIndex.find(c.id);
+    if (it == g_committedIndex.end()) {
+        g_committedIndex[c.id] = g_committed.size();
+        g_committed.push_back(c);
+        return;
+    }
+    NoteChange& prev = g_committed[it->second];
+    if (prev.kind == ChangeKind::Inserted && c.kind == ChangeKind::Updated) return; // still new
+    prev.kind = c.kind;
+}
+
+void noteChangesCommitted() {
+    if (g_txOverflow) g_overflow = true;
+    for (auto& c : g_txChanges) mergeChange(c);
+    g_txChanges.clear();
+    g_txOverflow = false;
+    if (g_committed.size() > kMaxPendingChanges) g_overflow = true;
+}
+
+static void onRollback(void*) {
+    g_txChanges.clear();
+    g_txOverflow = false;
+}
+
+void installChangeTracking() {
+    g_txChanges.clear();
+    g_txOverflow = false;
+    g_committed.clear();
+    g_committedIndex.clear();
+    g_overflow = false;
+    if (!db) return;
+    sqlite3_update_hook(db, onUpdate, nullptr);
+    sqlite3_rollback_hook(db, onRollback, nullptr);
+}
+
+bool takeNoteChanges(std::vector<NoteChange>& out) {
+    bool ok = !g_overflow;
+    out.swap(g_committed);
+    g_committed.clear();
+    g_committedIndex.clear();
+    g_overflow = false;
+    if (!ok) out.clear();
+    return ok;
+}
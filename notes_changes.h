@@ -0,0 +1,22 @@
+// notes_changes.h
+// change tracking on top of sqlite3_update_hook: which note ids were written
+// by committed transactions, so the list can be patched instead of rebuilt.
+#pragma once
+#include "notes_db.h"
+#include <vector>
+
+enum class ChangeKind { Inserted, Updated, Deleted };
+
+struct NoteChange {
+    ChangeKind kind;
+    int id;
+    bool matches; // filled by the consumer: does the row belong in the current list
+    Note note;    // filled by the consumer: id, title and preview
+};
+
+// hooks db (initDatabase does this); forgets anything still pending
+void installChangeTracking();
+
+// changes committed since the last call, one entry per id in first-touch order.
+// false if too many piled up to be worth patching (caller should rebuild).
+bool takeNoteChanges(std::vector<NoteChange>& out);
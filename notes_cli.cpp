@@ -0,0 +1,371 @@
+// notes_cli.cpp
+// headless front end over the same storage code as the app, for scripts,
+// cron jobs and load tests. results go to stdout (tab separated, or JSON
+// lines with --json); every command ends with one JSON timing line on stderr:
+//   {"cmd":"search","ok":true,"ms":1.234,"rows":17}
+//
+//   notes_cli [--db=notes.db] [--profile=balanced] [--mode=substring] [--json]
+//             [--trace=trace.json] [--trace-events=N] [--metrics=metrics.prom] [--slow-ms=N]
+//             [--resident]
+//             <command> ...
+//     add <title> [<content> | -]          (- or nothing: content from stdin)
+//     update <id> <title> [<content> | -]
+//     get <id>
+//     search <query> [--limit=N]
+//     list [--limit=N] [--before=ID]
+//     import <dir> [--title=filename|firstline] [--threads=N]
+//     export <path> [--format=jsonl|files] [--threads=N]
+//     gen <count> [--seed=N] [--max-bytes=N] [--threads=N]
+//     stats
+#include "notes_corpus.h"
+#include "notes_export.h"
+#include "notes_import.h"
+#include "notes_metrics.h"
+#include "notes_resident.h"
+#include "notes_slowlog.h"
+#include "notes_trace.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// ---------------- arguments ----------------
+// --name=value options may appear anywhere, everything else is positional
+struct Args {
+    std::vector<std::string> positional;
+    std::vector<std::pair<std::string, std::string>> options;
+
+    const char* get(const char* name, const char* def) const {
+        for (auto& o : options) {
+            if (o.first == name) return o.second.c_str();
+        }
+        return def;
+    }
+    bool has(const char* name) const { return get(name, nullptr) != nullptr; }
+};
+
+static Args parseArgs(int argc, char** argv) {
+    Args a;
+    for (int i = 1; i < argc; i++) {
+        const char* s = argv[i];
+        if (std::strncmp(s, "--", 2) == 0 && s[2]) {
+            const char* eq = std::strchr(s, '=');
+            if (eq) a.options.emplace_back(std::string(s + 2, eq - s - 2), std::string(eq + 1));
+            else a.options.emplace_back(std::string(s + 2), std::string());
+        } else {
+            a.positional.push_back(s);
+        }
+    }
+    return a;
+}
+
+static int usage() {
+    std::fprintf(stderr,
+        "usage: notes_cli [--db=notes.db] [--profile=durable|balanced|throughput]\n"
+        "                 [--mode=like|substring|prefix|ranked] [--json] [--trace=FILE]\n"
+        "                 [--trace-events=N] [--metrics=FILE] [--slow-ms=N] [--resident]\n"
+        "                 <command> ...\n"
+        "  add <title> [<content> | -]\n"
+        "  update <id> <title> [<content> | -]\n"
+        "  get <id>\n"
+        "  search <query> [--limit=N]\n"
+        "  list [--limit=N] [--before=ID]\n"
+        "  import <dir> [--title=filename|firstline] [--threads=N]\n"
+        "  export <path> [--format=jsonl|files] [--threads=N]\n"
+        "  gen <count> [--seed=N] [--max-bytes=N] [--threads=N]\n"
+        "  stats\n");
+    return 2;
+}
+
+static std::string readStdin() {
+    std::string s;
+    char buf[65536];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), stdin)) > 0) s.append(buf, n);
+    return s;
+}
+
+// ---------------- output ----------------
+static bool g_json = false;
+
+// one note per line: "id<TAB>title<TAB>content" (tabs/newlines in text escaped)
+// or {"id":..,"title":..,"content":..}
+static void printNote(const Note& n) {
+    std::string line;
+    if (g_json) {
+        line = "{\"id\":" + std::to_string(n.id) + ",\"title\":";
+        appendJsonString(line, n.title.data(), n.title.size());
+        line += ",\"content\":";
+        appendJsonString(line, n.content.data(), n.content.size());
+        line += "}\n";
+    } else {
+        line = std::to_string(n.id);
+        for (const std::string* s : { &n.title, &n.content }) {
+            line += '\t';
+            for (char c : *s) {
+                if (c == '\t') line += "\\t";
+                else if (c == '\n') line += "\\n";
+                else if (c == '\r') line += "\\r";
+                else if (c == '\\') line += "\\\\";
+                else line += c;
+            }
+        }
+        line += '\n';
+    }
+    std::fwrite(line.data(), 1, line.size(), stdout);
+}
+
+// the machine-readable summary every command ends with
+struct Timing {
+    std::string cmd;
+    bool ok = false;
+    double ms = 0;
+    std::vector<std::pair<const char*, double>> values;
+    std::string error;
+};
+
+static void printTiming(const Timing& t) {
+    std::string line = "{\"cmd\":";
+    appendJsonString(line, t.cmd.data(), t.cmd.size());
+    line += t.ok ? ",\"ok\":true" : ",\"ok\":false";
+    char num[64];
+    std::snprintf(num, sizeof(num), ",\"ms\":%.3f", t.ms);
+    line += num;
+    for (auto& v : t.values) {
+        // counts as integers, times in ms with 3 decimals
+        if (v.second == (double)(long long)v.second) std::snprintf(num, sizeof(num), "%lld", (long long)v.second);
+        else std::snprintf(num, sizeof(num), "%.3f", v.second);
+        line += ",\"" + std::string(v.first) + "\":" + num;
+    }
+    if (!t.error.empty()) {
+        line += ",\"error\":";
+        appendJsonString(line, t.error.data(), t.error.size());
+    }
+    line += "}\n";
+    std::fflush(stdout);
+    std::fwrite(line.data(), 1, line.size(), stderr);
+}
+
+static long long queryInt(const char* sql) {
+    long long v = 0;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+        v = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return v;
+}
+
+// ---------------- commands ----------------
+static bool cmdAdd(const Args& a, Timing& t) {
+    if (a.positional.size() < 2) return false;
+    const std::string& title = a.positional[1];
+    std::string content = (a.positional.size() < 3 || a.positional[2] == "-") ? readStdin() : a.positional[2];
+    Clock::time_point t0 = Clock::now();
+    t.ok = insertNotePrepared(title, content);
+    t.ms = msSince(t0);
+    if (t.ok) {
+        int id = (int)sqlite3_last_insert_rowid(db);
+        t.values.emplace_back("id", id);
+        std::printf(g_json ? "{\"id\":%d}\n" : "%d\n", id);
+    }
+    return true;
+}
+
+static bool cmdUpdate(const Args& a, Timing& t) {
+    if (a.positional.size() < 3) return false;
+    int id = std::atoi(a.positional[1].c_str());
+    std::string content = (a.positional.size() < 4 || a.positional[3] == "-") ? readStdin() : a.positional[3];
+    Note n = { id, a.positional[2], content };
+    std::vector<NoteWriteResult> out;
+    Clock::time_point t0 = Clock::now();
+    t.ok = updateNotes(&n, 1, out) && out[0].ok; // tells a missing id apart from a failure
+    t.ms = msSince(t0);
+    t.values.emplace_back("id", id);
+    if (!t.ok && t.error.empty()) t.error = "no note " + std::to_string(id);
+    return true;
+}
+
+static bool cmdGet(const Args& a, Timing& t) {
+    if (a.positional.size() < 2) return false;
+    int id = std::atoi(a.positional[1].c_str());
+    Note n;
+    Clock::time_point t0 = Clock::now();
+    t.ok = loadNote(id, n);
+    t.ms = msSince(t0);
+    if (t.ok) {
+        printNote(n);
+        t.values.emplace_back("bytes", (double)n.content.size());
+    } else {
+        t.error = "no note " + std::to_string(id);
+    }
+    return true;
+}
+
+// search and list are the same read: one keyset page of the list query
+static bool cmdList(const Args& a, Timing& t, const std::string& q) {
+    int limit = std::atoi(a.get("limit", "-1"));
+    int before = std::atoi(a.get("before", "0"));
+    NotePage page;
+    Clock::time_point t0 = Clock::now();
+    t.ok = fetchNotePage(q, before, limit, page);
+    t.ms = msSince(t0);
+    for (auto& n : page.notes) printNote(n);
+    t.values.emplace_back("rows", (double)page.notes.size());
+    if (page.more) t.values.emplace_back("next_before", page.nextBefore);
+    t.values.emplace_back("index_ready", searchIndexReady() ? 1 : 0);
+    return true;
+}
+
+static bool cmdImport(const Args& a, Timing& t) {
+    if (a.positional.size() < 2) return false;
+    ImportOptions o;
+    o.title = std::string(a.get("title", "filename")) == "firstline" ? ImportTitle::FirstLine : ImportTitle::FileName;
+    o.threads = std::atoi(a.get("threads", "0"));
+    ImportProgress p;
+    Clock::time_point t0 = Clock::now();
+    t.ok = importDirectory(a.positional[1], o, p, t.error);
+    t.ms = msSince(t0);
+    // leave the database fully indexed, not for the next open to finish
+    t0 = Clock::now();
+    waitForSearchIndex();
+    t.values.emplace_back("index_ms", msSince(t0));
+    t.values.emplace_back("files", (double)p.filesTotal);
+    t.values.emplace_back("imported", (double)p.imported);
+    t.values.emplace_back("failed", (double)p.failed);
+    t.values.emplace_back("bytes", (double)p.bytes);
+    return true;
+}
+
+static bool cmdExport(const Args& a, Timing& t) {
+    if (a.positional.size() < 2) return false;
+    ExportOptions o;
+    o.threads = std::atoi(a.get("threads", "0"));
+    std::string format = a.get("format", "jsonl");
+    ExportProgress p;
+    Clock::time_point t0 = Clock::now();
+    if (format == "files") t.ok = exportFiles(a.positional[1], o, p, t.error);
+    else if (format == "jsonl") t.ok = exportJsonl(a.positional[1], o, p, t.error);
+    else return false;
+    t.ms = msSince(t0);
+    t.values.emplace_back("notes", (double)p.notes);
+    t.values.emplace_back("failed", (double)p.failed);
+    t.values.emplace_back("bytes", (double)p.bytes);
+    return true;
+}
+
+// synthetic notes (notes_corpus.h), for benchmark fixtures
+static bool cmdGen(const Args& a, Timing& t) {
+    if (a.positional.size() < 2) return false;
+    CorpusOptions o;
+    o.seed = std::strtoull(a.get("seed", "1"), nullptr, 10);
+    if (a.has("max-bytes")) o.maxNoteBytes = (size_t)std::strtoull(a.get("max-bytes", ""), nullptr, 10);
+    CorpusWriteOptions w;
+    w.threads = std::atoi(a.get("threads", "0"));
+    CorpusProgress p;
+    Clock::time_point t0 = Clock::now();
+    t.ok = writeCorpus((size_t)std::strtoull(a.positional[1].c_str(), nullptr, 10), o, w, p, t.error);
+    t.ms = msSince(t0);
+    t0 = Clock::now();
+    waitForSearchIndex();
+    t.values.emplace_back("index_ms", msSince(t0));
+    t.values.emplace_back("notes", (double)p.notes);
+    t.values.emplace_back("bytes", (double)p.bytes);
+    t.values.emplace_back("seed", (double)o.seed);
+    return true;
+}
+
+static bool cmdStats(Timing& t) {
+    Clock::time_point t0 = Clock::now();
+    long long notes = queryInt("SELECT count(*) FROM notes;");
+    t.ms = msSince(t0);
+    t.ok = true;
+    t.values.emplace_back("notes", (double)notes);
+    t.values.emplace_back("max_id", (double)queryInt("SELECT ifnull(max(id), 0) FROM notes;"));
+    t.values.emplace_back("content_bytes", (double)queryInt("SELECT ifnull(sum(length(CAST(content AS BLOB))), 0) FROM notes;"));
+    t.values.emplace_back("db_bytes", (double)(queryInt("PRAGMA page_count;") * queryInt("PRAGMA page_size;")));
+    t.values.emplace_back("free_pages", (double)queryInt("PRAGMA freelist_count;"));
+    t.values.emplace_back("index_ready", searchIndexReady() ? 1 : 0);
+    std::printf(g_json ? "{\"notes\":%lld,\"profile\":\"%s\"}\n" : "notes\t%lld\nprofile\t%s\n", notes,
+        profileName(dbProfile()));
+    return true;
+}
+
+// ---------------- main ----------------
+int main(int argc, char** argv) {
+    Args a = parseArgs(argc, argv);
+    if (a.positional.empty()) return usage();
+    g_json = a.has("json");
+
+    DbProfile profile = DbProfile::Balanced;
+    if (!profileFromName(a.get("profile", "balanced"), profile)) return usage();
+    setDbProfile(profile);
+    std::string mode = a.get("mode", "substring");
+    if (mode == "like") setSearchMode(SearchMode::Like);
+    else if (mode == "substring") setSearchMode(SearchMode::Substring);
+    else if (mode == "prefix") setSearchMode(SearchMode::Prefix);
+    else if (mode == "ranked") setSearchMode(SearchMode::Ranked);
+    else return usage();
+
+    // statements slower than N ms go to <db>-slow.log with their plan
+    if (a.has("slow-ms")) {
+        SlowLogOptions slow;
+        slow.thresholdMs = std::atoi(a.get("slow-ms", "0"));
+        enableSlowQueryLog(slow);
+    }
+
+    // every note in memory too, list and LIKE search answered from there
+    if (a.has("resident")) enableResidentCorpus(ResidentOptions());
+
+    // spans kept per thread for --trace (default TRACE_RING_EVENTS)
+    if (a.has("trace-events")) setTraceRingEvents((size_t)std::atoi(a.get("trace-events", "0")));
+    TRACE_THREAD_NAME("main");
+    Timing t;
+    t.cmd = a.positional[0];
+    Clock::time_point t0 = Clock::now();
+    if (!initDatabase(a.get("db", "notes.db"))) {
+        t.error = lastDbError();
+        printTiming(t);
+        return 1;
+    }
+    t.values.emplace_back("open_ms", msSince(t0));
+    if (a.has("resident")) t.values.emplace_back("resident_load_ms", residentStats().loadMs);
+
+    bool known = true;
+    if (t.cmd == "add") known = cmdAdd(a, t);
+    else if (t.cmd == "update") known = cmdUpdate(a, t);
+    else if (t.cmd == "get") known = cmdGet(a, t);
+    else if (t.cmd == "search") known = a.positional.size() >= 2 && cmdList(a, t, a.positional[1]);
+    else if (t.cmd == "list") known = cmdList(a, t, "");
+    else if (t.cmd == "import") known = cmdImport(a, t);
+    else if (t.cmd == "export") known = cmdExport(a, t);
+    else if (t.cmd == "gen") known = cmdGen(a, t);
+    else if (t.cmd == "stats") known = cmdStats(t);
+    else known = false;
+
+    if (!known) {
+        closeDatabase();
+        return usage();
+    }
+    if (!t.ok && t.error.empty()) t.error = lastDbError();
+    // SQLite's counters after the command, OpenMetrics text
+    if (a.has("metrics")) {
+        setMetricsFile(a.get("metrics", ""));
+        sampleDbMetrics();
+    }
+    closeDatabase();
+    if (a.has("slow-ms")) t.values.emplace_back("slow_logged", (double)slowLogStats().logged);
+    // spans of the whole run, background threads included (needs -DNOTES_TRACE=ON)
+    std::string traceErr;
+    if (a.has("trace") && !writeTrace(a.get("trace", ""), traceErr)) std::fprintf(stderr, "%s\n", traceErr.c_str());
+    printTiming(t);
+    return t.ok ? 0 : 1;
+}
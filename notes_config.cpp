@@ -0,0 +1,250 @@
+// notes_config.cpp
+// connection setup: journal mode and pragmas come from a DbProfile, and WAL
+// checkpoints run on a background thread with its own connection, so a save
+// never pays for copying the log back into notes.db.
+#include "notes_internal.h"
+#include "notes_trace.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+static std::atomic<DbProfile> g_profile(DbProfile::Balanced);
+
+static std::thread g_checkpointThread;
+static std::mutex g_checkpointLock;
+static std::condition_variable g_checkpointWake;
+static bool g_checkpointWanted = false; // under g_checkpointLock
+static bool g_checkpointStop = false;   // under g_checkpointLock
+static int g_checkpointPages = 0;       // WAL size that wakes the thread
+static int g_nextWakePages = 0;         // only touched by walHook (the writing thread)
+
+static std::atomic<long long> g_checkpointRuns(0);
+static std::atomic<long long> g_checkpointBusy(0);
+static std::atomic<long long> g_checkpointRestarts(0);
+static std::atomic<long long> g_checkpointCopied(0);
+
+DbConfig profileConfig(DbProfile p) {
+    DbConfig c;
+    c.wal = true;
+    c.tempInMemory = true;
+    c.pageSize = 4096;
+    switch (p) {
+    case DbProfile::Durable:
+        // every commit fsyncs the WAL: nothing is lost even on power failure
+        c.synchronous = 2;
+        c.cacheKiB = 8 * 1024;
+        c.mmapBytes = 0;
+        c.checkpointPages = 1000;
+        break;
+    case DbProfile::Balanced:
+    default:
+        // fsync only at checkpoints: an app crash loses nothing, a power cut may
+        // lose the last commits but never corrupts the file
+        c.synchronous = 1;
+        c.cacheKiB = 16 * 1024;
+        c.mmapBytes = 64LL * 1024 * 1024;
+        c.checkpointPages = 1000;
+        break;
+    case DbProfile::Throughput:
+        // no fsync at all, for imports and benchmarks that can be re-run
+        c.synchronous = 0;
+        c.cacheKiB = 64 * 1024;
+        c.mmapBytes = 256LL * 1024 * 1024;
+        c.pageSize = 8192;
+        c.checkpointPages = 4000;
+        break;
+    }
+    return c;
+}
+
+const char* profileName(DbProfile p) {
+    switch (p) {
+    case DbProfile::Durable: return "durable";
+    case DbProfile::Balanced: return "balanced";
+    case DbProfile::Throughput: return "throughput";
+    }
+    return "?";
+}
+
+bool profileFromName(const std::string& name, DbProfile& out) {
+    for (DbProfile p : { DbProfile::Durable, DbProfile::Balanced, DbProfile::Throughput }) {
+        if (name == profileName(p)) {
+            out = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+void setDbProfile(DbProfile p) {
+    g_profile = p;
+}
+
+DbProfile dbProfile() {
+    return g_profile;
+}
+
+CheckpointStats checkpointStats() {
+    CheckpointStats s;
+    s.runs = g_checkpointRuns;
+    s.busy = g_checkpointBusy;
+    s.restarts = g_checkpointRestarts;
+    s.pagesCopied = g_checkpointCopied;
+    return s;
+}
+
+// ---------------- checkpointer ----------------
+// runs on the committing thread after every commit: only decides, never copies
+static int walHook(void*, sqlite3*, const char*, int pages) {
+    // once per threshold's worth of new pages, not after every commit
+    if (pages < g_nextWakePages - g_checkpointPages) g_nextWakePages = g_checkpointPages; // log was reset
+    if (pages >= g_nextWakePages) {
+        g_nextWakePages = pages + g_checkpointPages;
+        std::lock_guard<std::mutex> lock(g_checkpointLock);
+        if (!g_checkpointWanted) {
+            g_checkpointWanted = true;
+            g_checkpointWake.notify_one();
+        }
+    }
+    return SQLITE_OK;
+}
+
+static void checkpointMain(std::string path) {
+    TRACE_THREAD_NAME("checkpointer");
+    sqlite3* cdb = nullptr;
+    if (sqlite3_open_v2(path.c_str(), &cdb, SQLITE_OPEN_READWRITE, nullptr) != SQLITE_OK) {
+        sqlite3_close(cdb);
+        return;
+    }
+    sqlite3_busy_timeout(cdb, 1000);
+    int lastCopied = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(g_checkpointLock);
+            g_checkpointWake.wait(lock, [] { return g_checkpointWanted || g_checkpointStop; });
+            if (g_checkpointStop) break;
+            g_checkpointWanted = false;
+        }
+        // a connection only notices the file is in WAL mode once it has read it;
+        // until then the checkpoint call is a no-op
+        sqlite3_exec(cdb, "SELECT 1 FROM sqlite_master LIMIT 1;", nullptr, nullptr, nullptr);
+        // PASSIVE never blocks the writer; pages still needed by a reader are
+        // left for the next round
+        TRACE_SCOPE("checkpoint");
+        int logPages = 0, copied = 0;
+        int rc = sqlite3_wal_checkpoint_v2(cdb, "main", SQLITE_CHECKPOINT_PASSIVE, &logPages, &copied);
+        g_checkpointRuns++;
+        if (rc == SQLITE_BUSY) g_checkpointBusy++;
+        // copied counts from the start of the log, which begins again after a reset
+        g_checkpointCopied += copied >= lastCopied ? copied - lastCopied : copied;
+        lastCopied = copied;
+
+        // the writer only starts the log over if it finds it fully copied, which a
+        // steady stream of commits never lets happen. past 4x the threshold, copy
+        // the last few pages while holding writers off, so the next commit resets it.
+        if (rc == SQLITE_OK && logPages >= 4 * g_checkpointPages) {
+            rc = sqlite3_wal_checkpoint_v2(cdb, "main", SQLITE_CHECKPOINT_RESTART, &logPages, &copied);
+            if (rc == SQLITE_OK) {
+                g_checkpointRestarts++;
+                g_checkpointCopied += copied >= lastCopied ? copied - lastCopied : copied;
+                lastCopied = 0;
+            } else {
+                g_checkpointBusy++;
+            }
+        }
+    }
+    sqlite3_close(cdb);
+}
+
+// ---------------- busy handler ----------------
+// busy_timeout's wait (5 s), plus a note of when db last had to wait: the
+// background indexer checks it between chunks and lets the waiting write in
+// first, instead of winning every race for the lock
+static const int kBusyTimeoutMs = 5000;
+static std::atomic<long long> g_lastBusyMs(-1000000);
+
+static long long nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static int busyHandler(void*, int count) {
+    // short sleeps, so the write gets in soon after the lock is let go
+    static const int kDelaysMs[] = { 1, 2, 5, 10 };
+    static const int kWaitedMs[] = { 0, 1, 3, 8 };
+    g_lastBusyMs = nowMs();
+    int waited = count < 4 ? kWaitedMs[count] : 18 + (count - 4) * 10;
+    if (waited >= kBusyTimeoutMs) return 0;
+    std::this_thread::sleep_for(std::chrono::milliseconds(count < 4 ? kDelaysMs[count] : 10));
+    return 1;
+}
+
+bool foregroundWriteWaiting() {
+    return nowMs() - g_lastBusyMs < 20;
+}
+
+// ---------------- connection setup ----------------
+static bool execPragma(const std::string& sql, std::string& err) {
+    char* errmsg = nullptr;
+    if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errmsg) != SQLITE_OK) {
+        err = errmsg ? errmsg : sql;
+        sqlite3_free(errmsg);
+        return false;
+    }
+    return true;
+}
+
+bool configureConnection(std::string& err) {
+    DbConfig c = profileConfig(g_profile);
+    sqlite3_busy_handler(db, busyHandler, nullptr);
+    // page_size only applies while the file is still empty (before journal_mode=WAL)
+    if (!execPragma("PRAGMA page_size = " + std::to_string(c.pageSize) + ";", err)) return false;
+
+    bool wal = false;
+    if (c.wal) {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, "PRAGMA journal_mode = WAL;", -1, &stmt, nullptr) == SQLITE_OK &&
+            sqlite3_step(stmt) == SQLITE_ROW) {
+            // in-memory databases (and some file systems) stay on their old journal
+            const unsigned char* mode = sqlite3_column_text(stmt, 0);
+            wal = mode && sqlite3_stricmp((const char*)mode, "wal") == 0;
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    std::string sql =
+        "PRAGMA synchronous = " + std::to_string(c.synchronous) + ";"
+        "PRAGMA cache_size = -" + std::to_string(c.cacheKiB) + ";"
+        "PRAGMA mmap_size = " + std::to_string(c.mmapBytes) + ";"
+        "PRAGMA temp_store = " + (c.tempInMemory ? "MEMORY" : "DEFAULT") + ";";
+    // a checkpointed WAL is reused from the start; this trims it back afterwards
+    if (wal) sql += "PRAGMA journal_size_limit = " + std::to_string(64LL * 1024 * 1024) + ";";
+    if (!execPragma(sql, err)) return false;
+
+    const char* file = sqlite3_db_filename(db, "main");
+    if (!wal || !file || !*file || c.checkpointPages <= 0) return true;
+
+    // replaces SQLite's own auto-checkpoint, which would run inside the commit
+    g_checkpointPages = c.checkpointPages;
+    g_nextWakePages = c.checkpointPages;
+    g_checkpointWanted = false;
+    g_checkpointStop = false;
+    sqlite3_wal_hook(db, walHook, nullptr);
+    g_checkpointThread = std::thread(checkpointMain, std::string(file));
+    return true;
+}
+
+void closeConnection() {
+    if (db) sqlite3_wal_hook(db, nullptr, nullptr);
+    if (g_checkpointThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(g_checkpointLock);
+            g_checkpointStop = true;
+            g_checkpointWake.notify_one();
+        }
+        g_checkpointThread.join();
+    }
+    // closing the last connection checkpoints whatever is left and removes the WAL
+}
@@ -0,0 +1,394 @@
+// notes_corpus.cpp
+#include "notes_corpus.h"
+#include "notes_trace.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// ---------------- random numbers ----------------
+// splitmix64: one word of state, so a note's stream starts from (seed, index)
+// directly and notes can be made in any order
+struct CorpusRng {
+    uint64_t s;
+    uint64_t next() {
+        uint64_t z = (s += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    // 0 .. n-1
+    uint32_t below(uint32_t n) { return (uint32_t)(((next() >> 32) * n) >> 32); }
+    // true in perMille of 1000 calls
+    bool chance(uint32_t perMille) { return below(1000) < perMille; }
+    double unit() { return (double)(next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+// ---------------- vocabulary ----------------
+// the most frequent words of each language, most frequent first; a generated
+// tail of rare words follows them in the rank order
+static const char* kIndonesian[] = {
+    "yang", "dan", "di", "ini", "itu", "dengan", "untuk", "tidak", "ke", "dari",
+    "dalam", "akan", "pada", "juga", "saya", "ada", "bisa", "sudah", "kita", "aku",
+    "kami", "mereka", "harus", "lebih", "karena", "atau", "seperti", "jika", "oleh", "tersebut",
+    "hari", "besok", "rapat", "kerja", "catatan", "belanja", "jangan", "lupa", "beli", "bayar",
+    "sama", "bagus", "belum", "lagi", "masih", "hanya", "semua", "banyak", "baru", "waktu",
+    "orang", "rumah", "kantor", "teman", "keluarga", "anak", "ibu", "bapak", "kakak", "adik",
+    "minggu", "bulan", "tahun", "pagi", "siang", "sore", "malam", "jam", "tanggal", "jadwal",
+    "proyek", "laporan", "keuangan", "anggaran", "tagihan", "listrik", "air", "internet", "pulsa", "gaji",
+    "ide", "tugas", "kuliah", "ujian", "dosen", "kelas", "buku", "baca", "tulis", "kirim",
+    "email", "pesan", "telepon", "nomor", "alamat", "jalan", "kota", "pasar", "toko", "harga",
+    "beras", "telur", "minyak", "gula", "kopi", "teh", "susu", "roti", "sayur", "buah",
+    "ayam", "ikan", "daging", "nasi", "makan", "minum", "masak", "resep", "bumbu", "garam",
+    "perlu", "mau", "ingin", "coba", "buat", "pakai", "ambil", "bawa", "cari", "tanya",
+    "jawab", "bilang", "kata", "tahu", "lihat", "dengar", "pikir", "rasa", "suka", "senang",
+    "sedih", "capek", "sakit", "dokter", "obat", "sehat", "olahraga", "lari", "jalan-jalan", "libur",
+    "mudik", "lebaran", "puasa", "kantin", "kanan", "kiri", "depan", "belakang", "atas", "bawah",
+    "besar", "kecil", "panjang", "pendek", "cepat", "lambat", "mahal", "murah", "penting", "segera",
+    "nanti", "tadi", "kemarin", "sekarang", "selalu", "sering", "kadang", "pernah", "mungkin", "pasti",
+    "agar", "supaya", "tetapi", "namun", "lalu", "kemudian", "setelah", "sebelum", "sampai", "sejak",
+    "meeting", "deadline", "revisi", "presentasi", "klien", "kontrak", "invoice", "transfer", "rekening", "bank",
+    "kantong", "motor", "mobil", "bensin", "parkir", "ojek", "kereta", "bus", "tiket", "pesawat",
+};
+
+static const char* kEnglish[] = {
+    "the", "of", "and", "to", "a", "in", "is", "it", "you", "that",
+    "for", "on", "with", "as", "was", "be", "at", "this", "have", "from",
+    "or", "by", "not", "but", "what", "all", "are", "we", "can", "will",
+    "do", "if", "my", "one", "about", "up", "out", "so", "get", "need",
+    "meeting", "todo", "shopping", "draft", "notes", "review", "budget", "travel", "call", "email",
+    "tomorrow", "today", "week", "month", "year", "morning", "afternoon", "evening", "night", "time",
+    "project", "report", "plan", "idea", "task", "list", "buy", "pay", "send", "check",
+    "remember", "ask", "tell", "book", "ticket", "flight", "hotel", "trip", "visit", "home",
+    "work", "office", "team", "client", "deadline", "sprint", "slides", "agenda", "minutes", "follow",
+    "milk", "eggs", "bread", "coffee", "tea", "rice", "chicken", "cheese", "apples", "water",
+    "doctor", "dentist", "gym", "run", "walk", "read", "write", "learn", "study", "class",
+    "important", "urgent", "later", "soon", "maybe", "done", "pending", "next", "last", "first",
+    "new", "old", "good", "bad", "big", "small", "long", "short", "more", "less",
+    "should", "would", "could", "must", "might", "also", "just", "only", "then", "when",
+    "after", "before", "until", "because", "while", "where", "which", "who", "how", "why",
+    "people", "family", "friend", "kids", "mom", "dad", "birthday", "gift", "party", "dinner",
+    "lunch", "breakfast", "recipe", "cook", "clean", "fix", "car", "bike", "train", "bus",
+    "bill", "rent", "invoice", "bank", "transfer", "account", "password", "phone", "address", "number",
+    "monday", "tuesday", "wednesday", "thursday", "friday", "weekend", "holiday", "vacation", "summer", "winter",
+    "kanban", "backlog", "release", "bug", "feature", "test", "deploy", "server", "database", "update",
+};
+
+// accented and non-Latin words, as people paste them
+static const char* kMultibyte[] = {
+    "café", "naïve", "résumé", "jalapeño", "Zürich", "São Paulo", "Müller", "façade",
+    "crème brûlée", "smörgåsbord", "Łódź", "piñata", "Ελλάδα", "Москва", "東京", "日本語",
+    "한국어", "北京", "مرحبا", "שלום", "हिन्दी", "ภาษาไทย", "Việt Nam", "Đà Nẵng",
+    "Tiếng Việt", "Straße", "Ærø", "Ñuñoa", "½", "°C", "€", "…",
+};
+
+static const char* kEmoji[] = {
+    "😀", "😂", "🙏", "👍", "🎉", "🔥", "✅", "📌",
+    "📝", "🛒", "☕", "💡", "📅", "🚀", "🤔", "😭",
+    "❤️", "🇮🇩", "👨‍👩‍👧", "👍🏽", "🧑‍💻", "⚠️", "⭐", "🍜",
+};
+
+static const int kZipfBits = 20;
+static const int kTailWords = 20000;
+
+struct Vocabulary {
+    std::vector<std::string> words; // by rank
+    std::vector<uint16_t> zipf;     // 2^kZipfBits equally likely slots -> rank
+
+    const std::string& pick(CorpusRng& r) const { return words[zipf[r.next() >> (64 - kZipfBits)]]; }
+};
+
+// rare words made of the language's syllables, from a fixed seed so the
+// vocabulary is the same for every corpus seed
+static void addTail(std::vector<std::string>& words, bool english) {
+    static const char* kIdOnset[] = { "b", "c", "d", "g", "h", "j", "k", "l", "m", "n", "p", "r", "s", "t", "w", "y", "ng", "ny", "" };
+    static const char* kIdVowel[] = { "a", "a", "i", "u", "e", "o" };
+    static const char* kIdCoda[] = { "", "", "", "n", "ng", "r", "s", "t", "k", "l" };
+    static const char* kIdPrefix[] = { "me", "ber", "di", "ter", "pe", "ke" };
+    static const char* kIdSuffix[] = { "kan", "an", "nya", "i" };
+    static const char* kEnOnset[] = { "b", "bl", "br", "c", "ch", "cl", "cr", "d", "dr", "f", "fl", "fr", "g", "gl", "gr", "h", "j",
+                                      "k", "l", "m", "n", "p", "pl", "pr", "r", "s", "sh", "sl", "sp", "st", "str", "t", "th", "tr", "v", "w", "" };
+    static const char* kEnVowel[] = { "a", "e", "i", "o", "u", "ea", "ee", "oo", "ou", "ai" };
+    static const char* kEnCoda[] = { "", "", "n", "r", "t", "s", "ck", "ll", "nd", "ng", "st", "th" };
+    static const char* kEnSuffix[] = { "ing", "ed", "er", "ly", "tion", "s", "ness" };
+#define PICK(a) a[r.below((uint32_t)(sizeof(a) / sizeof(a[0])))]
+
+    CorpusRng r = { english ? 0x656e676c697368ull : 0x696e646f6e6573ull };
+    std::unordered_set<std::string> seen(words.begin(), words.end());
+    size_t want = words.size() + kTailWords;
+    while (words.size() < want) {
+        std::string w;
+        if (!english && r.chance(300)) w += PICK(kIdPrefix);
+        int syllables = 2 + (int)r.below(3);
+        for (int i = 0; i < syllables; i++) {
+            w += english ? PICK(kEnOnset) : PICK(kIdOnset);
+            w += english ? PICK(kEnVowel) : PICK(kIdVowel);
+            if (i == syllables - 1 || r.chance(250)) w += english ? PICK(kEnCoda) : PICK(kIdCoda);
+        }
+        if (r.chance(250)) w += english ? PICK(kEnSuffix) : PICK(kIdSuffix);
+        if (w.size() >= 3 && seen.insert(w).second) words.push_back(w);
+    }
+#undef PICK
+}
+
+// P(rank k) ~ 1/(k+1), sampled through a table of equally likely slots
+static Vocabulary buildVocabulary(const char* const* top, size_t count, bool english) {
+    Vocabulary v;
+    v.words.assign(top, top + count);
+    addTail(v.words, english);
+    size_t n = v.words.size();
+    double total = 0;
+    for (size_t k = 0; k < n; k++) total += 1.0 / (double)(k + 1);
+    const size_t slots = (size_t)1 << kZipfBits;
+    v.zipf.resize(slots);
+    size_t k = 0;
+    double cdf = 1.0;
+    for (size_t j = 0; j < slots; j++) {
+        double u = ((double)j + 0.5) / (double)slots * total;
+        while (cdf < u && k + 1 < n) cdf += 1.0 / (double)(++k + 1);
+        v.zipf[j] = (uint16_t)k;
+    }
+    return v;
+}
+
+enum CorpusLang { Indonesian, English };
+
+static const Vocabulary& vocabulary(CorpusLang lang) {
+    static const Vocabulary id = buildVocabulary(kIndonesian, sizeof(kIndonesian) / sizeof(kIndonesian[0]), false);
+    static const Vocabulary en = buildVocabulary(kEnglish, sizeof(kEnglish) / sizeof(kEnglish[0]), true);
+    return lang == English ? en : id;
+}
+
+// ---------------- text ----------------
+// content length mix (per million notes), log-uniform inside each band
+static const struct {
+    uint32_t perMillion;
+    size_t lo, hi;
+} kLengths[] = {
+    { 400000, 4, 80 },                 // "beli susu", a phone number
+    { 450000, 80, 800 },               // a few lines
+    { 134000, 800, 8192 },
+    { 15000, 8192, 128u << 10 },
+    { 995, 128u << 10, 1u << 20 },
+    { 5, 1u << 20, 8u << 20 },         // pasted logs, whole documents
+};
+
+static size_t pickLength(CorpusRng& r) {
+    uint32_t u = r.below(1000000);
+    for (auto& band : kLengths) {
+        if (u < band.perMillion) return (size_t)((double)band.lo * std::exp(r.unit() * std::log((double)band.hi / (double)band.lo)));
+        u -= band.perMillion;
+    }
+    return kLengths[0].lo;
+}
+
+static void appendNumber(std::string& out, CorpusRng& r, CorpusLang lang) {
+    char buf[48];
+    unsigned day = 1 + r.below(28), month = 1 + r.below(12), year = 2015 + r.below(12);
+    switch (r.below(6)) {
+    case 0: std::snprintf(buf, sizeof(buf), "%02u/%02u/%04u", day, month, year); break;
+    case 1: std::snprintf(buf, sizeof(buf), "%04u-%02u-%02u", year, month, day); break;
+    case 2: std::snprintf(buf, sizeof(buf), "%02u:%02u", r.below(24), r.below(4) * 15); break;
+    case 3:
+        if (lang == Indonesian) std::snprintf(buf, sizeof(buf), "Rp %u.%03u", 1 + r.below(999), r.below(20) * 50);
+        else std::snprintf(buf, sizeof(buf), "$%u.%02u", 1 + r.below(500), r.below(100));
+        break;
+    case 4: std::snprintf(buf, sizeof(buf), "%u%%", r.below(101)); break;
+    default: std::snprintf(buf, sizeof(buf), "%u", 1 + r.below(r.chance(800) ? 20 : 100000)); break;
+    }
+    out += buf;
+}
+
+static void appendToken(std::string& out, CorpusRng& r, CorpusLang lang) {
+    uint32_t u = r.below(1000);
+    if (u < 12) out += kMultibyte[r.below((uint32_t)(sizeof(kMultibyte) / sizeof(kMultibyte[0])))];
+    else if (u < 20) out += kEmoji[r.below((uint32_t)(sizeof(kEmoji) / sizeof(kEmoji[0])))];
+    else if (u < 35) appendNumber(out, r, lang);
+    else out += vocabulary(lang).pick(r);
+}
+
+// words separated by spaces (and the odd comma), the first one capitalized
+static void appendWords(std::string& out, CorpusRng& r, CorpusLang lang, int words) {
+    for (int i = 0; i < words; i++) {
+        if (i) out += r.chance(60) ? ", " : " ";
+        size_t start = out.size();
+        appendToken(out, r, lang);
+        if (i == 0 && out[start] >= 'a' && out[start] <= 'z') out[start] -= 'a' - 'A';
+    }
+}
+
+static void appendSentence(std::string& out, CorpusRng& r, CorpusLang lang) {
+    appendWords(out, r, lang, 3 + (int)r.below(14));
+    uint32_t u = r.below(100);
+    out += u < 85 ? "." : u < 93 ? "?" : "!";
+}
+
+// a paragraph, a list or a heading, ending in a line break
+static void appendBlock(std::string& out, CorpusRng& r, CorpusLang lang) {
+    uint32_t kind = r.below(100);
+    if (kind < 10) {
+        static const char* kBullets[] = { "- ", "* ", "[ ] ", "[x] " };
+        int bullet = (int)r.below(5); // 4: numbered
+        int items = 2 + (int)r.below(6);
+        for (int i = 0; i < items; i++) {
+            if (bullet == 4) out += std::to_string(i + 1) + ". ";
+            else out += kBullets[bullet];
+            appendWords(out, r, lang, 1 + (int)r.below(6));
+            out += "\r\n";
+        }
+    } else if (kind < 14) {
+        out += "# ";
+        appendWords(out, r, lang, 1 + (int)r.below(4));
+        out += "\r\n";
+    } else {
+        int sentences = 1 + (int)r.below(5);
+        for (int i = 0; i < sentences; i++) {
+            if (i) out += ' ';
+            appendSentence(out, r, lang);
+        }
+        out += "\r\n";
+    }
+}
+
+// cut s to at most n bytes: at a space or line break in the second half if
+// there is one (no half words for the index), else at a UTF-8 boundary
+static void cutText(std::string& s, size_t n) {
+    if (s.size() <= n) return;
+    size_t end = n;
+    size_t brk = s.find_last_of(" \r\n", end);
+    if (brk != std::string::npos && brk >= n / 2) {
+        end = brk;
+    } else {
+        while (end > 0 && ((unsigned char)s[end] & 0xC0) == 0x80) end--;
+    }
+    while (end > 0 && (s[end - 1] == ' ' || s[end - 1] == ',' || s[end - 1] == '\r' || s[end - 1] == '\n')) end--;
+    s.resize(end);
+}
+
+void corpusNote(const CorpusOptions& options, unsigned long long index, Note& note) {
+    CorpusRng r = { options.seed * 0xD1B54A32D192ED03ull ^ index };
+    r.next();
+    // 60% Indonesian, 25% English, 15% switching per block
+    uint32_t u = r.below(100);
+    bool mixed = u >= 85;
+    CorpusLang lang = u < 60 ? Indonesian : English;
+
+    note.id = 0;
+    note.title.clear();
+    appendWords(note.title, r, lang, 1 + (int)r.below(6));
+    if (r.chance(80)) {
+        note.title += ' ';
+        note.title += kEmoji[r.below((uint32_t)(sizeof(kEmoji) / sizeof(kEmoji[0])))];
+    }
+
+    size_t length = std::min(pickLength(r), options.maxNoteBytes);
+    note.content.clear();
+    note.content.reserve(length + 256);
+    while (note.content.size() < length) {
+        if (!note.content.empty() && r.chance(700)) note.content += "\r\n";
+        appendBlock(note.content, r, mixed ? (CorpusLang)r.below(2) : lang);
+    }
+    cutText(note.content, length);
+}
+
+// ---------------- writing ----------------
+// same shape as importDirectory: generators fill batches in any order, the
+// calling thread inserts them in order and stays at most a few batches behind
+struct CorpusBatch {
+    bool ready = false;
+    std::vector<Note> notes;
+};
+
+bool writeCorpus(size_t count, const CorpusOptions& options, const CorpusWriteOptions& write,
+                 CorpusProgress& result, std::string& err) {
+    TRACE_SCOPE("writeCorpus");
+    result = CorpusProgress{ 0, 0 };
+    if (!db) {
+        err = "database not open";
+        return false;
+    }
+    if (count == 0) return true;
+
+    unsigned long long first = 0;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT ifnull(max(id), 0) FROM notes;", -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW) {
+        first = (unsigned long long)sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+
+    size_t perBatch = std::max<size_t>(1, write.batchNotes);
+    size_t batchCount = (count + perBatch - 1) / perBatch;
+    int threads = write.threads > 0 ? write.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    threads = (int)std::min<size_t>((size_t)threads, batchCount);
+    size_t ahead = (size_t)threads * 2;
+
+    std::vector<CorpusBatch> batches(batchCount);
+    std::mutex lock;
+    std::condition_variable changed;
+    size_t nextBatch = 0; // under lock
+    size_t written = 0;   // under lock
+    bool abort = false;   // under lock
+
+    auto generator = [&]() {
+        TRACE_THREAD_NAME("corpus generator");
+        for (;;) {
+            size_t k;
+            {
+                std::unique_lock<std::mutex> l(lock);
+                changed.wait(l, [&] { return abort || nextBatch >= batchCount || nextBatch < written + ahead; });
+                if (abort || nextBatch >= batchCount) return;
+                k = nextBatch++;
+            }
+            TRACE_SCOPE_DETAIL("generate batch", nullptr, (long long)k);
+            CorpusBatch b;
+            size_t begin = k * perBatch, end = std::min(count, begin + perBatch);
+            b.notes.resize(end - begin);
+            for (size_t i = begin; i < end; i++) corpusNote(options, first + i, b.notes[i - begin]);
+            b.ready = true;
+            std::lock_guard<std::mutex> l(lock);
+            batches[k] = std::move(b);
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; i++) pool.emplace_back(generator);
+
+    bool ok = true;
+    std::vector<NoteWriteResult> out;
+    for (size_t k = 0; k < batchCount; k++) {
+        CorpusBatch b;
+        {
+            std::unique_lock<std::mutex> l(lock);
+            changed.wait(l, [&] { return batches[k].ready; });
+            b = std::move(batches[k]);
+            batches[k] = CorpusBatch();
+        }
+        if (!insertNotes(b.notes, out)) {
+            err = lastDbError();
+            ok = false;
+            break;
+        }
+        for (auto& n : b.notes) result.bytes += n.title.size() + n.content.size();
+        result.notes += b.notes.size();
+        {
+            std::lock_guard<std::mutex> l(lock);
+            written = k + 1;
+            changed.notify_all();
+        }
+        if (write.progress) write.progress(result, write.user);
+    }
+    {
+        std::lock_guard<std::mutex> l(lock);
+        abort = !ok;
+        changed.notify_all();
+    }
+    for (auto& t : pool) t.join();
+    return ok;
+}
@@ -0,0 +1,43 @@
+// notes_corpus.h
+// synthetic notes for benchmarks and fixtures: Indonesian, English and mixed
+// text with Zipf-distributed words, a long tail of rare words, accented/non-Latin
+// words and emoji, lists and numbers, and lengths from a few bytes to megabytes.
+// everything follows from (seed, note number), so the same options give the
+// same corpus on every machine and whatever the thread count.
+#pragma once
+#include "notes_db.h"
+#include <cstddef>
+#include <string>
+
+struct CorpusOptions {
+    unsigned long long seed = 1;
+    size_t maxNoteBytes = 8u << 20; // cap on content length (the length mix goes up to 8MB)
+};
+
+// note number index of the corpus: title and content (UTF-8, CRLF line ends,
+// like the editor saves); id is set to 0
+void corpusNote(const CorpusOptions& options, unsigned long long index, Note& note);
+
+struct CorpusProgress {
+    size_t notes; // written so far
+    unsigned long long bytes;
+};
+
+// called on the writing thread after every batch
+typedef void (*CorpusProgressCallback)(const CorpusProgress& progress, void* user);
+
+struct CorpusWriteOptions {
+    int threads = 0;           // generators, 0 = one per core
+    size_t batchNotes = 10000; // notes per insertNotes call (and transaction)
+    CorpusProgressCallback progress = nullptr;
+    void* user = nullptr;
+};
+
+// append count notes to the open database. note numbers continue from the
+// current max(id), so on an empty database ids and note numbers line up and
+// two runs of 500000 give the same notes as one of 1000000. each batch commits
+// on its own (the log stays small); on failure (err) the batches already
+// written stay. indexing of the new rows runs in the background, see
+// waitForSearchIndex.
+bool writeCorpus(size_t count, const CorpusOptions& options, const CorpusWriteOptions& write,
+                 CorpusProgress& result, std::string& err);
@@ -0,0 +1,535 @@
+// notes_db.cpp
+#include "notes_internal.h"
+#include "notes_changes.h"
+#include "notes_search.h"
+#include "notes_simd.h"
+#include "notes_trace.h"
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+
+sqlite3* db = nullptr;
+
+static std::string g_lastError;
+static std::atomic<uint64_t> g_writeGeneration(0);
+// a bulk insert inside beginWrite/commitWrite left rows for the index catch-up,
+// which can only start once they are committed
+static bool g_catchUpAfterCommit = false;
+
+const std::string& lastDbError() {
+    return g_lastError;
+}
+
+// ---------------- SQLite helpers ----------------
+static bool hasColumn(const char* table, const char* column) {
+    std::string sql = std::string("PRAGMA table_info(") + table + ");";
+    sqlite3_stmt* stmt = nullptr;
+    bool found = false;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        while (!found && sqlite3_step(stmt) == SQLITE_ROW) {
+            const unsigned char* name = sqlite3_column_text(stmt, 1);
+            found = name && std::string((const char*)name) == column;
+        }
+    }
+    sqlite3_finalize(stmt);
+    return found;
+}
+
+// note_preview(content): makePreview for SQL
+static void notePreviewFunc(sqlite3_context* ctx, int, sqlite3_value** argv) {
+    const unsigned char* t = sqlite3_value_text(argv[0]);
+    if (!t) {
+        sqlite3_result_null(ctx);
+        return;
+    }
+    std::string preview = makePreview(std::string((const char*)t, (size_t)sqlite3_value_bytes(argv[0])));
+    sqlite3_result_text(ctx, preview.c_str(), (int)preview.size(), SQLITE_TRANSIENT);
+}
+
+// note_contains(text, pattern): pattern occurs in text as it is, no wildcards
+// (ASCII case is ignored too). the searches pass the folded column and
+// foldText of the query, so this matches with Unicode case folding and
+// diacritics stripped ("Čatatan" finds "CATATAN"); a % or _ in the pattern is
+// just a character. the compiled pattern is kept once per statement as auxdata
+// on the pattern argument
+static void deletePattern(void* p) {
+    delete (NoCasePattern*)p;
+}
+
+static void noteContainsFunc(sqlite3_context* ctx, int, sqlite3_value** argv) {
+    const unsigned char* text = sqlite3_value_text(argv[0]);
+    if (!text || sqlite3_value_type(argv[1]) == SQLITE_NULL) {
+        sqlite3_result_null(ctx);
+        return;
+    }
+    size_t len = (size_t)sqlite3_value_bytes(argv[0]);
+    const NoCasePattern* p = (const NoCasePattern*)sqlite3_get_auxdata(ctx, 1);
+    if (p) {
+        sqlite3_result_int(ctx, containsNoCase(*p, (const char*)text, len));
+        return;
+    }
+    NoCasePattern* compiled = new NoCasePattern();
+    const unsigned char* pattern = sqlite3_value_text(argv[1]);
+    compileNoCase((const char*)pattern, (size_t)sqlite3_value_bytes(argv[1]), *compiled);
+    sqlite3_result_int(ctx, containsNoCase(*compiled, (const char*)text, len));
+    // SQLite may free it right away (a pattern that is not a constant)
+    sqlite3_set_auxdata(ctx, 1, compiled, deletePattern);
+}
+
+void foldNote(const std::string& title, const std::string& content, std::string& out) {
+    out.clear();
+    foldText(title.data(), title.size(), out);
+    out += '\n';
+    foldText(content.data(), content.size(), out);
+}
+
+// note_fold(title, content): foldNote for SQL, for rows written without the
+// folded column (other programs, older versions) and the migration below
+static void noteFoldFunc(sqlite3_context* ctx, int, sqlite3_value** argv) {
+    const unsigned char* title = sqlite3_value_text(argv[0]);
+    std::string folded;
+    if (title) foldText((const char*)title, (size_t)sqlite3_value_bytes(argv[0]), folded);
+    folded += '\n';
+    const unsigned char* content = sqlite3_value_text(argv[1]);
+    if (content) foldText((const char*)content, (size_t)sqlite3_value_bytes(argv[1]), folded);
+    sqlite3_result_text(ctx, folded.c_str(), (int)folded.size(), SQLITE_TRANSIENT);
+}
+
+// one-time migration for databases from before the preview or folded column.
+// the table is rebuilt (not ALTER ... ADD COLUMN) so both land in front of
+// content; ids and the AUTOINCREMENT counter are kept, the FTS triggers are
+// re-created afterwards.
+static const char* kSqlMigrateNotes =
+    "BEGIN IMMEDIATE;"
+    "CREATE TABLE notes_new ("
+    "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+    "title TEXT, "
+    "preview TEXT, "
+    "folded TEXT, "
+    "content TEXT);"
+    "INSERT INTO notes_new (id, title, preview, folded, content) "
+    "  SELECT id, title, note_preview(content), note_fold(title, content), content FROM notes;"
+    "CREATE TEMP TABLE old_seq AS SELECT seq FROM sqlite_sequence WHERE name = 'notes';"
+    "DROP TABLE notes;"
+    "ALTER TABLE notes_new RENAME TO notes;"
+    "UPDATE sqlite_sequence SET seq = max(seq, ifnull((SELECT seq FROM old_seq), 0)) WHERE name = 'notes';"
+    "DROP TABLE old_seq;"
+    "COMMIT;";
+
+static void columnText(sqlite3_stmt* stmt, int col, std::string& out) {
+    const unsigned char* t = sqlite3_column_text(stmt, col);
+    if (t) out.assign((const char*)t, (size_t)sqlite3_column_bytes(stmt, col));
+    else out.clear();
+}
+
+void registerSqlFunctions(sqlite3* conn) {
+    sqlite3_create_function(conn, "note_preview", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr,
+                            notePreviewFunc, nullptr, nullptr);
+    sqlite3_create_function(conn, "note_contains", 2, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr,
+                            noteContainsFunc, nullptr, nullptr);
+    sqlite3_create_function(conn, "note_fold", 2, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr,
+                            noteFoldFunc, nullptr, nullptr);
+}
+
+// rows another program (or an older version) wrote without the folded column:
+// the scans fold them on the fly, but the trigram index only sees the column.
+// the partial index keeps them findable without a table scan on every open.
+// an edit that leaves folded as it was (another writer changing the text
+// alone) gets folded and preview cleared by notes_refold, so the row is folded
+// on the fly until the next open refills it. the trigger calls no app function:
+// writers without note_fold (the sqlite3 shell) compile it too
+static bool foldNewRows(std::string& err) {
+    char* errmsg = nullptr;
+    int rc = sqlite3_exec(db,
+        "DROP TRIGGER IF EXISTS notes_refold;"
+        "CREATE TRIGGER notes_refold AFTER UPDATE OF title, content ON notes "
+        "WHEN new.folded IS old.folded BEGIN"
+        "  UPDATE notes SET folded = NULL, preview = NULL WHERE id = new.id;"
+        "END;"
+        "CREATE INDEX IF NOT EXISTS notes_unfolded ON notes(id) WHERE folded IS NULL;"
+        "UPDATE notes SET folded = note_fold(title, content), preview = ifnull(preview, note_preview(content)) "
+        "WHERE folded IS NULL;",
+        nullptr, nullptr, &errmsg);
+    if (rc != SQLITE_OK) {
+        err = errmsg ? errmsg : sqlite3_errstr(rc);
+        sqlite3_free(errmsg);
+        return false;
+    }
+    return true;
+}
+
+bool initDatabase(const char* path) {
+    int rc = sqlite3_open(path, &db);
+    if (rc != SQLITE_OK) {
+        g_lastError = db ? sqlite3_errmsg(db) : "out of memory";
+        if (db) sqlite3_close(db);
+        db = nullptr;
+        return false;
+    }
+    std::string err;
+    if (!configureConnection(err)) {
+        g_lastError = "DB Init Error: " + err;
+        closeConnection();
+        sqlite3_close(db);
+        db = nullptr;
+        return false;
+    }
+    openSlowQueryLog();
+    registerSqlFunctions(db);
+    // preview and folded sit before content so neither the list nor a scan
+    // search ever walks content's overflow pages
+    const char* sql =
+        "CREATE TABLE IF NOT EXISTS notes ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "title TEXT, "
+        "preview TEXT, "
+        "folded TEXT, "
+        "content TEXT);";
+    char* errmsg = nullptr;
+    rc = sqlite3_exec(db, sql, nullptr, nullptr, &errmsg);
+    if (rc == SQLITE_OK && (!hasColumn("notes", "preview") || !hasColumn("notes", "folded"))) {
+        rc = sqlite3_exec(db, kSqlMigrateNotes, nullptr, nullptr, &errmsg);
+        if (rc != SQLITE_OK) sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+    }
+    if (rc != SQLITE_OK) {
+        g_lastError = "DB Init Error: ";
+        g_lastError += errmsg ? errmsg : "";
+        sqlite3_free(errmsg);
+        closeSlowQueryLog();
+        closeConnection();
+        sqlite3_close(db);
+        db = nullptr;
+        return false;
+    }
+    if (!initSearchIndex(err)) {
+        g_lastError = "DB Init Error: " + err;
+        closeSlowQueryLog();
+        closeConnection();
+        sqlite3_close(db);
+        db = nullptr;
+        return false;
+    }
+    if (!foldNewRows(err)) {
+        g_lastError = "DB Init Error: " + err;
+        closeSearchIndex();
+        closeSlowQueryLog();
+        closeConnection();
+        sqlite3_close(db);
+        db = nullptr;
+        return false;
+    }
+    installChangeTracking();
+    loadResidentCorpus();
+    return true;
+}
+
+void closeDatabase() {
+    closeResidentCorpus();
+    closeSearchIndex();
+    closeSlowQueryLog();
+    closeConnection();
+    clearStmtCache();
+    if (db) sqlite3_close(db);
+    db = nullptr;
+}
+
+static const char* kSqlInsertNote = "INSERT INTO notes (title, content, preview, folded) VALUES (?, ?, ?, ?);";
+static const char* kSqlUpdateNote = "UPDATE notes SET title = ?, content = ?, preview = ?, folded = ? WHERE id = ?;";
+// notes_refold clears both when the edit leaves folded as it was (a case-only
+// change of the title): put them back
+static const char* kSqlRefillNote = "UPDATE notes SET preview = ?1, folded = ?2 WHERE id = ?3 AND folded IS NULL;";
+
+// one row through a borrowed insert/update statement (id > 0 = update).
+// the strings are bound SQLITE_STATIC and must outlive the step. the folded
+// text is made here, once per write, so searches never fold a row
+static bool writeNoteRow(sqlite3_stmt* stmt, int id, const std::string& title, const std::string& content,
+                         const std::string& preview) {
+    static std::string folded; // db's thread only, reused between rows
+    foldNote(title, content, folded);
+    sqlite3_bind_text(stmt, 1, title.c_str(), (int)title.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, content.c_str(), (int)content.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, preview.c_str(), (int)preview.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 4, folded.c_str(), (int)folded.size(), SQLITE_STATIC);
+    if (id > 0) sqlite3_bind_int(stmt, 5, id);
+    int rc = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    if (rc != SQLITE_DONE) {
+        g_lastError = sqlite3_errmsg(db);
+        return false;
+    }
+    bool written = sqlite3_changes(db) > 0;
+    if (written && id > 0) {
+        StmtScope r(kSqlRefillNote);
+        if (!r.stmt) return false;
+        sqlite3_bind_text(r.stmt, 1, preview.c_str(), (int)preview.size(), SQLITE_STATIC);
+        sqlite3_bind_text(r.stmt, 2, folded.c_str(), (int)folded.size(), SQLITE_STATIC);
+        sqlite3_bind_int(r.stmt, 3, id);
+        if (sqlite3_step(r.stmt) != SQLITE_DONE) {
+            g_lastError = sqlite3_errmsg(db);
+            return false;
+        }
+    }
+    if (written) residentWritten(id > 0 ? id : (int)sqlite3_last_insert_rowid(db), title, content, folded);
+    // outside a transaction the statement has committed already
+    if (sqlite3_get_autocommit(db)) noteChangesCommitted();
+    return true;
+}
+
+bool insertNotePrepared(const std::string& title, const std::string& content) {
+    TRACE_SCOPE("insertNotePrepared");
+    if (!db) return false;
+    std::string preview = makePreview(content);
+    StmtScope q(kSqlInsertNote);
+    if (!q.stmt || !writeNoteRow(q.stmt, 0, title, content, preview)) return false;
+    g_writeGeneration++;
+    return true;
+}
+
+bool updateNotePrepared(int id, const std::string& title, const std::string& content) {
+    TRACE_SCOPE_DETAIL("updateNotePrepared", nullptr, id);
+    if (!db) return false;
+    std::string preview = makePreview(content);
+    StmtScope q(kSqlUpdateNote);
+    if (!q.stmt || !writeNoteRow(q.stmt, id, title, content, preview)) return false;
+    g_writeGeneration++;
+    return true;
+}
+
+// ---------------- bulk writes ----------------
+// shared by insertNotes/updateNotes: one statement, reset between rows, all of
+// it inside one transaction (the caller's, if one is already open)
+static bool writeNotes(bool update, const Note* notes, size_t count, std::vector<NoteWriteResult>& out) {
+    TRACE_SCOPE_DETAIL(update ? "updateNotes" : "insertNotes", nullptr, (long long)count);
+    out.assign(count, NoteWriteResult{ false, 0 });
+    if (!db) return false;
+    if (count == 0) return true;
+    bool own = sqlite3_get_autocommit(db) != 0;
+    if (own && !beginWrite()) return false;
+
+    // big inserts are indexed afterwards in one pass, a lot cheaper than the
+    // FTS triggers row by row
+    bool deferred = !update && count >= BULK_DEFER_INDEX_ROWS && deferIndexing();
+    size_t written = 0;
+    {
+        StmtScope q(update ? kSqlUpdateNote : kSqlInsertNote);
+        if (!q.stmt) {
+            if (deferred) endDeferredIndexing();
+            if (own) rollbackWrite();
+            return false;
+        }
+        std::string preview;
+        for (size_t i = 0; i < count; i++) {
+            const Note& n = notes[i];
+            NoteWriteResult& r = out[i];
+            if (update && n.id <= 0) continue;
+            preview = makePreview(n.content);
+            if (!writeNoteRow(q.stmt, update ? n.id : 0, n.title, n.content, preview)) continue;
+            // an update of an id that does not exist writes nothing
+            if (update && sqlite3_changes(db) == 0) continue;
+            r.ok = true;
+            r.id = update ? n.id : (int)sqlite3_last_insert_rowid(db);
+            written++;
+        }
+    }
+
+    if ((deferred && !endDeferredIndexing()) || (own && !commitWrite())) {
+        if (own) rollbackWrite();
+        out.assign(count, NoteWriteResult{ false, 0 });
+        return false;
+    }
+    if (written) g_writeGeneration++;
+    if (deferred) {
+        if (own) startIndexCatchUp();
+        else g_catchUpAfterCommit = true; // started by the caller's commitWrite
+    }
+    return true;
+}
+
+bool insertNotes(const Note* notes, size_t count, std::vector<NoteWriteResult>& out) {
+    return writeNotes(false, notes, count, out);
+}
+
+bool updateNotes(const Note* notes, size_t count, std::vector<NoteWriteResult>& out) {
+    return writeNotes(true, notes, count, out);
+}
+
+static bool stepOnce(const char* sql) {
+    StmtScope q(sql);
+    if (!q.stmt) return false;
+    if (sqlite3_step(q.stmt) != SQLITE_DONE) {
+        g_lastError = sqlite3_errmsg(db);
+        return false;
+    }
+    return true;
+}
+
+bool beginWrite() {
+    return db && stepOnce("BEGIN IMMEDIATE;");
+}
+
+bool commitWrite() {
+    TRACE_SCOPE("commitWrite");
+    if (!db || !stepOnce("COMMIT;")) return false;
+    noteChangesCommitted();
+    residentCommitted();
+    if (g_catchUpAfterCommit) {
+        g_catchUpAfterCommit = false;
+        startIndexCatchUp();
+    }
+    return true;
+}
+
+void rollbackWrite() {
+    g_catchUpAfterCommit = false;
+    if (db && !sqlite3_get_autocommit(db)) stepOnce("ROLLBACK;");
+    residentRolledBack();
+}
+
+bool fetchNotePage(const std::string& q, int beforeId, int limit, NotePage& out) {
+    TRACE_SCOPE_DETAIL("fetchNotePage", q.empty() ? nullptr : "query", beforeId);
+    out.notes.clear();
+    out.nextBefore = beforeId;
+    out.more = false;
+    if (!db) return false;
+    if (residentAnswers(q)) {
+        residentPage(q, beforeId, limit, out);
+        return true;
+    }
+    std::string arg;
+    bool keyset = true;
+    StmtScope s(searchSql(q, arg, &keyset));
+    if (!s.stmt) return false;
+    if (!q.empty()) sqlite3_bind_text(s.stmt, 1, arg.c_str(), (int)arg.size(), SQLITE_STATIC);
+    if (keyset) {
+        sqlite3_bind_int64(s.stmt, 2, beforeId > 0 ? (sqlite3_int64)beforeId : INT64_MAX);
+        sqlite3_bind_int(s.stmt, 3, limit > 0 ? limit : -1);
+    }
+    TRACE_SCOPE("sqlite3_step rows");
+    int rc;
+    while ((rc = sqlite3_step(s.stmt)) == SQLITE_ROW) {
+        Note n;
+        n.id = sqlite3_column_int(s.stmt, 0);
+        columnText(s.stmt, 1, n.title);
+        columnText(s.stmt, 2, n.content);
+        // row not backfilled yet: column 2 is the whole content
+        if (sqlite3_column_int(s.stmt, 3)) n.content = makePreview(n.content);
+        out.notes.push_back(std::move(n));
+    }
+    if (!out.notes.empty()) out.nextBefore = out.notes.back().id;
+    // a full page means there may be more below it
+    out.more = keyset && limit > 0 && (int)out.notes.size() == limit;
+    return rc == SQLITE_DONE;
+}
+
+bool fetchNotes(const std::string& q, std::vector<Note>& out) {
+    NotePage page;
+    bool ok = fetchNotePage(q, 0, -1, page);
+    out.swap(page.notes);
+    return ok;
+}
+
+std::vector<Note> fetchNotes(const std::string& q) {
+    std::vector<Note> out;
+    fetchNotes(q, out);
+    return out;
+}
+
+bool loadNote(int id, Note& out) {
+    TRACE_SCOPE_DETAIL("loadNote", nullptr, id);
+    if (!db) return false;
+    if (residentLoaded()) return residentLoad(id, out);
+    StmtScope q("SELECT title, content FROM notes WHERE id = ? LIMIT 1;");
+    if (!q.stmt) return false;
+    sqlite3_bind_int(q.stmt, 1, id);
+    if (sqlite3_step(q.stmt) != SQLITE_ROW) return false;
+    out.id = id;
+    columnText(q.stmt, 0, out.title);
+    columnText(q.stmt, 1, out.content);
+    return true;
+}
+
+uint64_t writeGeneration() {
+    return g_writeGeneration.load();
+}
+
+std::string makePreview(const std::string& content) {
+    if (content.size() <= 300) return content;
+    return makePreview(content.data(), content.size());
+}
+
+std::string makePreview(const char* content, size_t len) {
+    if (len <= 300) return std::string(content, len);
+    // don't cut a UTF-8 sequence in half
+    size_t cut = 300;
+    while (cut > 0 && ((unsigned char)content[cut] & 0xC0) == 0x80) cut--;
+    return std::string(content, cut) + "...";
+}
+
+bool previewIsPartial(const std::string& preview) {
+    return preview.size() >= 3 && preview.compare(preview.size() - 3, 3, "...") == 0;
+}
+
+bool contentMatches(const std::vector<int>& ids, const std::string& q, std::vector<int>& out) {
+    out.clear();
+    if (!db) return false;
+    if (ids.empty()) return true;
+    if (residentLoaded() && matchableInMemory(q, searchMode())) {
+        residentContentMatches(ids, q, out);
+        return true;
+    }
+    std::string list = "[";
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (i) list += ',';
+        list += std::to_string(ids[i]);
+    }
+    list += ']';
+    // the folded text, with note_contains unless q has LIKE wildcards of its own
+    bool plain = !likeWildcards(q);
+    std::string pattern = plain ? foldText(q) : likePattern(q);
+    StmtScope s(plain ? "SELECT id FROM notes WHERE id IN (SELECT value FROM json_each(?1)) "
+                        "AND note_contains(ifnull(folded, note_fold(title, content)), ?2);"
+                      : "SELECT id FROM notes WHERE id IN (SELECT value FROM json_each(?1)) "
+                        "AND ifnull(folded, note_fold(title, content)) LIKE ?2 ESCAPE '\\';");
+    if (!s.stmt) return false;
+    sqlite3_bind_text(s.stmt, 1, list.c_str(), (int)list.size(), SQLITE_STATIC);
+    sqlite3_bind_text(s.stmt, 2, pattern.c_str(), (int)pattern.size(), SQLITE_STATIC);
+    int rc;
+    while ((rc = sqlite3_step(s.stmt)) == SQLITE_ROW) out.push_back(sqlite3_column_int(s.stmt, 0));
+    return rc == SQLITE_DONE;
+}
+
+// ---------------- statement cache ----------------
+static std::unordered_map<std::string, sqlite3_stmt*> g_stmtCache;
+static long long g_stmtHits = 0;
+static long long g_stmtMisses = 0;
+
+sqlite3_stmt* cachedStatement(const char* sql) {
+    if (!db) return nullptr;
+    auto it = g_stmtCache.find(sql);
+    if (it != g_stmtCache.end()) {
+        g_stmtHits++;
+        return it->second;
+    }
+    g_stmtMisses++;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v3(db, sql, -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK) {
+        g_lastError = sqlite3_errmsg(db);
+        sqlite3_finalize(stmt);
+        return nullptr;
+    }
+    g_stmtCache.emplace(sql, stmt);
+    return stmt;
+}
+
+void clearStmtCache() {
+    for (auto& kv : g_stmtCache) sqlite3_finalize(kv.second);
+    g_stmtCache.clear();
+}
+
+StmtCacheStats stmtCacheStats() {
+    StmtCacheStats st;
+    st.hits = g_stmtHits;
+    st.misses = g_stmtMisses;
+    st.size = (int)g_stmtCache.size();
+    return st;
+}
@@ -0,0 +1,170 @@
+// notes_db.h
+// portable storage core (no Win32 here) - dipakai main.cpp dan tool headless
+#pragma once
+#include "sqlite3.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// the single connection used by the app
+extern sqlite3* db;
+
+// fetch notes (id, title, content). rows from the list queries (fetchNotes,
+// fetchNotePage) carry the preview in content; loadNote gives the whole text.
+struct Note {
+    int id;
+    std::string title;
+    std::string content;
+};
+
+// ---------------- SQLite helpers ----------------
+// open (or create) the notes database; on failure lastDbError() has the reason
+bool initDatabase(const char* path = "notes.db");
+void closeDatabase();
+const std::string& lastDbError();
+
+bool insertNotePrepared(const std::string& title, const std::string& content);
+bool updateNotePrepared(int id, const std::string& title, const std::string& content);
+// bulk writes: every row in one transaction (or in the caller's, if one is
+// open) through one reused statement. out gets an entry per input row: ok and
+// the note's id (the new one for inserts). updateNotes uses each Note's id and
+// reports ids that do not exist as not ok. false if the transaction failed,
+// in which case nothing was written.
+// from this many rows on, insertNotes leaves the search index to a background
+// catch-up (searches fall back to LIKE until searchIndexReady() again)
+const size_t BULK_DEFER_INDEX_ROWS = 256;
+
+struct NoteWriteResult {
+    bool ok;
+    int id;
+};
+bool insertNotes(const Note* notes, size_t count, std::vector<NoteWriteResult>& out);
+bool updateNotes(const Note* notes, size_t count, std::vector<NoteWriteResult>& out);
+inline bool insertNotes(const std::vector<Note>& notes, std::vector<NoteWriteResult>& out) {
+    return insertNotes(notes.data(), notes.size(), out);
+}
+inline bool updateNotes(const std::vector<Note>& notes, std::vector<NoteWriteResult>& out) {
+    return updateNotes(notes.data(), notes.size(), out);
+}
+
+// group several writes into one transaction (one commit, one fsync); the
+// *Prepared calls above join it. a failed row does not undo the others.
+bool beginWrite();
+bool commitWrite();
+void rollbackWrite();
+
+std::vector<Note> fetchNotes(const std::string& q = "");
+// same, but says whether the query ran to completion (false on error or sqlite3_interrupt)
+bool fetchNotes(const std::string& q, std::vector<Note>& out);
+
+// one keyset page of fetchNotes(q): matching rows with id < beforeId
+// (0 = from the top), newest first, at most limit rows (-1 = all)
+struct NotePage {
+    std::vector<Note> notes;
+    int nextBefore; // beforeId for the following page; rows >= this are complete
+    bool more;      // false once the end of the list was reached
+};
+bool fetchNotePage(const std::string& q, int beforeId, int limit, NotePage& out);
+
+// load one note for the editor window, false if id does not exist
+bool loadNote(int id, Note& out);
+
+// bumped by every successful insert/update; anything derived from earlier
+// reads (cached search results etc.) is stale once this changes
+uint64_t writeGeneration();
+
+// what a card shows: the first 300 bytes of content plus "...", stored in the
+// preview column by insert/update so the list never reads whole notes
+std::string makePreview(const std::string& content);
+std::string makePreview(const char* content, size_t len);
+// true if preview may have been cut (the rest of the content is unknown)
+bool previewIsPartial(const std::string& preview);
+
+// ids (out of ids) whose full text contains q, folded the way searches compare
+bool contentMatches(const std::vector<int>& ids, const std::string& q, std::vector<int>& out);
+
+// ---------------- connection profile ----------------
+// how initDatabase configures the connection (set it before opening).
+// all profiles use WAL, so readers never wait for a save; they differ in
+// how often SQLite fsyncs and how much memory it may use.
+//   Durable    : synchronous=FULL, every commit survives a power cut
+//   Balanced   : synchronous=NORMAL, the default for the app
+//   Throughput : synchronous=OFF, bigger cache/mmap, for imports and benchmarks
+enum class DbProfile { Durable, Balanced, Throughput };
+
+struct DbConfig {
+    bool wal;
+    int synchronous;     // 0 = OFF, 1 = NORMAL, 2 = FULL
+    int cacheKiB;        // page cache of the connection
+    long long mmapBytes; // 0 = no memory-mapped reads
+    bool tempInMemory;   // temp_store = MEMORY
+    int pageSize;        // only used when the file is created
+    int checkpointPages; // WAL size that wakes the background checkpointer
+};
+DbConfig profileConfig(DbProfile p);
+const char* profileName(DbProfile p);
+bool profileFromName(const std::string& name, DbProfile& out);
+
+void setDbProfile(DbProfile p);
+DbProfile dbProfile();
+
+// work done by the background checkpointer since the program started
+struct CheckpointStats {
+    long long runs;
+    long long busy;        // runs that could not copy everything (a reader was active)
+    long long restarts;    // WAL grown past 4x the threshold, reset while holding writers off
+    long long pagesCopied; // WAL pages written back into the database file
+};
+CheckpointStats checkpointStats();
+
+// ---------------- full-text search ----------------
+// Like      : substring scan of the folded column: case and diacritics are
+//             ignored (foldText, notes_simd.h), % and _ in q are LIKE wildcards
+// Substring : the same, answered by the trigram index, but % and _ are plain
+//             characters, whatever the length of q and also while the index is
+//             still being built (the scan that stands in for it then takes
+//             them literally too). only Like has wildcards
+// Prefix    : every word of q as a prefix ("cat" finds "catatan"), newest first
+// Ranked    : like Prefix, ordered by bm25 relevance
+enum class SearchMode { Like, Substring, Prefix, Ranked };
+
+void setSearchMode(SearchMode mode);
+SearchMode searchMode();
+// q is matched with its % and _ as wildcards: it has some and the mode is Like
+bool likeWildcards(const std::string& q);
+
+// false while an existing database is still being indexed in the background;
+// fetchNotes quietly uses Like until then
+bool searchIndexReady();
+// the mode a search runs in right now: searchMode(), or Like while the index
+// is not ready. results kept for later (caches, refinement) are keyed by it
+SearchMode effectiveSearchMode();
+void waitForSearchIndex();
+
+// ---------------- statement cache ----------------
+// compiled statements stay alive for the lifetime of the connection;
+// cachedStatement returns a reset statement with no bindings
+sqlite3_stmt* cachedStatement(const char* sql);
+void clearStmtCache();
+
+struct StmtCacheStats {
+    long long hits;
+    long long misses;
+    int size;
+};
+StmtCacheStats stmtCacheStats();
+
+// borrow a cached statement for one scope; reset on exit so it never holds a read lock.
+// anything bound with SQLITE_STATIC must be declared before the scope.
+struct StmtScope {
+    sqlite3_stmt* stmt;
+    explicit StmtScope(const char* sql) : stmt(cachedStatement(sql)) {}
+    ~StmtScope() {
+        if (stmt) {
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+        }
+    }
+    StmtScope(const StmtScope&) = delete;
+    StmtScope& operator=(const StmtScope&) = delete;
+};
@@ -0,0 +1,252 @@
+// notes_export.cpp
+#include "notes_export.h"
+#include "notes_trace.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const char* kSqlExport = "SELECT id, title, content FROM notes ORDER BY id;";
+static const size_t kChunkBytes = 1u << 20;
+
+static FILE* openForWrite(const fs::path& path) {
+#ifdef _WIN32
+    return _wfopen(path.c_str(), L"wb");
+#else
+    return std::fopen(path.c_str(), "wb");
+#endif
+}
+
+// rows of the export query, read straight off the statement; the statement is
+// private (not the cache) so a long export never holds a shared one
+struct ExportCursor {
+    sqlite3_stmt* stmt = nullptr;
+    ~ExportCursor() { sqlite3_finalize(stmt); }
+    bool open(std::string& err) {
+        if (!db) {
+            err = "database not open";
+            return false;
+        }
+        if (sqlite3_prepare_v2(db, kSqlExport, -1, &stmt, nullptr) != SQLITE_OK) {
+            err = sqlite3_errmsg(db);
+            return false;
+        }
+        return true;
+    }
+};
+
+// ---------------- JSONL ----------------
+void appendJsonString(std::string& out, const char* s, size_t n) {
+    static const char kHex[] = "0123456789abcdef";
+    const unsigned char* p = (const unsigned char*)s;
+    out += '"';
+    size_t i = 0;
+    while (i < n) {
+        unsigned char c = p[i];
+        if (c < 0x80) {
+            switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    out += "\\u00";
+                    out += kHex[c >> 4];
+                    out += kHex[c & 15];
+                } else {
+                    out += (char)c;
+                }
+            }
+            i++;
+            continue;
+        }
+        // copy a well-formed UTF-8 sequence, anything else is one U+FFFD per byte
+        size_t len = (c >= 0xC2 && c <= 0xDF) ? 2 : (c >= 0xE0 && c <= 0xEF) ? 3 : (c >= 0xF0 && c <= 0xF4) ? 4 : 0;
+        bool ok = len > 0 && i + len <= n;
+        for (size_t k = 1; ok && k < len; k++) ok = (p[i + k] & 0xC0) == 0x80;
+        if (ok && len == 3) {
+            // no overlongs, no surrogates
+            ok = !(c == 0xE0 && p[i + 1] < 0xA0) && !(c == 0xED && p[i + 1] >= 0xA0);
+        } else if (ok && len == 4) {
+            ok = !(c == 0xF0 && p[i + 1] < 0x90) && !(c == 0xF4 && p[i + 1] >= 0x90);
+        }
+        if (ok) {
+            out.append((const char*)p + i, len);
+            i += len;
+        } else {
+            out += "\xEF\xBF\xBD";
+            i++;
+        }
+    }
+    out += '"';
+}
+
+bool exportJsonl(const std::string& file, const ExportOptions& options, ExportProgress& result, std::string& err) {
+    TRACE_SCOPE("exportJsonl");
+    result = ExportProgress{ 0, 0, 0 };
+    ExportCursor cur;
+    if (!cur.open(err)) return false;
+    FILE* f = openForWrite(fs::u8path(file));
+    if (!f) {
+        err = file + ": cannot create";
+        return false;
+    }
+
+    std::string buf;
+    buf.reserve(kChunkBytes + 64 * 1024);
+    bool ok = true;
+    int rc;
+    while (ok && (rc = sqlite3_step(cur.stmt)) == SQLITE_ROW) {
+        buf += "{\"id\":";
+        buf += std::to_string(sqlite3_column_int(cur.stmt, 0));
+        buf += ",\"title\":";
+        appendJsonString(buf, (const char*)sqlite3_column_blob(cur.stmt, 1), (size_t)sqlite3_column_bytes(cur.stmt, 1));
+        buf += ",\"content\":";
+        appendJsonString(buf, (const char*)sqlite3_column_blob(cur.stmt, 2), (size_t)sqlite3_column_bytes(cur.stmt, 2));
+        buf += "}\n";
+        result.notes++;
+        if (buf.size() >= kChunkBytes) {
+            ok = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+            result.bytes += buf.size();
+            buf.clear();
+        }
+        if (options.progress && result.notes % 1000 == 0) options.progress(result, options.user);
+    }
+    if (ok && rc != SQLITE_DONE) {
+        err = sqlite3_errmsg(db);
+        ok = false;
+    }
+    if (ok && !buf.empty()) {
+        ok = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+        result.bytes += buf.size();
+    }
+    if (std::fclose(f) != 0) ok = false;
+    if (!ok && err.empty()) err = file + ": write failed";
+    if (options.progress) options.progress(result, options.user);
+    return ok;
+}
+
+// ---------------- one file per note ----------------
+// "<id> <title>.txt", only characters every file system takes
+static std::string noteFileName(int id, const char* title, size_t n) {
+    std::string name = std::to_string(id);
+    std::string t;
+    for (size_t i = 0; i < n && t.size() < 80; i++) {
+        unsigned char c = (unsigned char)title[i];
+        if (c < 0x20 || std::string("<>:\"/\\|?*").find((char)c) != std::string::npos) t += '_';
+        else t += (char)c;
+    }
+    // don't end inside a UTF-8 sequence, nor in dots or spaces (Windows drops them)
+    size_t end = t.size();
+    if (end == 80) {
+        while (end > 0 && ((unsigned char)t[end - 1] & 0xC0) == 0x80) end--;
+        if (end > 0 && (unsigned char)t[end - 1] >= 0xC0) end--;
+    }
+    while (end > 0 && (t[end - 1] == '.' || t[end - 1] == ' ')) end--;
+    t.resize(end);
+    if (!t.empty()) name += ' ' + t;
+    return name + ".txt";
+}
+
+struct ExportFile {
+    std::string name;
+    std::string content;
+};
+
+bool exportFiles(const std::string& dir, const ExportOptions& options, ExportProgress& result, std::string& err) {
+    TRACE_SCOPE("exportFiles");
+    result = ExportProgress{ 0, 0, 0 };
+    ExportCursor cur;
+    if (!cur.open(err)) return false;
+    fs::path root = fs::u8path(dir);
+    std::error_code ec;
+    fs::create_directories(root, ec);
+    if (ec) {
+        err = dir + ": " + ec.message();
+        return false;
+    }
+
+    // the reading thread fills the queue, writers empty it; at most queueBytes
+    // of note text (or one note, if bigger) wait there
+    std::deque<ExportFile> queue;
+    size_t queued = 0;
+    bool done = false;
+    size_t failed = 0;
+    std::mutex lock;
+    std::condition_variable changed;
+
+    auto writer = [&]() {
+        TRACE_THREAD_NAME("export writer");
+        for (;;) {
+            ExportFile job;
+            {
+                std::unique_lock<std::mutex> l(lock);
+                changed.wait(l, [&] { return done || !queue.empty(); });
+                if (queue.empty()) return;
+                job = std::move(queue.front());
+                queue.pop_front();
+                queued -= job.content.size();
+                changed.notify_all();
+            }
+            FILE* f = openForWrite(root / fs::u8path(job.name));
+            bool ok = f && std::fwrite(job.content.data(), 1, job.content.size(), f) == job.content.size();
+            if (f && std::fclose(f) != 0) ok = false;
+            if (!ok) {
+                std::lock_guard<std::mutex> l(lock);
+                failed++;
+            }
+        }
+    };
+
+    int threads = options.threads > 0 ? options.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; i++) pool.emplace_back(writer);
+
+    int rc;
+    while ((rc = sqlite3_step(cur.stmt)) == SQLITE_ROW) {
+        ExportFile job;
+        job.name = noteFileName(sqlite3_column_int(cur.stmt, 0), (const char*)sqlite3_column_blob(cur.stmt, 1),
+                                (size_t)sqlite3_column_bytes(cur.stmt, 1));
+        const char* content = (const char*)sqlite3_column_blob(cur.stmt, 2);
+        if (content) job.content.assign(content, (size_t)sqlite3_column_bytes(cur.stmt, 2));
+        result.notes++;
+        result.bytes += job.content.size();
+        {
+            std::unique_lock<std::mutex> l(lock);
+            changed.wait(l, [&] { return queue.empty() || queued + job.content.size() <= options.queueBytes; });
+            queued += job.content.size();
+            queue.push_back(std::move(job));
+            changed.notify_all();
+        }
+        if (options.progress && result.notes % 1000 == 0) {
+            {
+                std::lock_guard<std::mutex> l(lock);
+                result.failed = failed;
+            }
+            options.progress(result, options.user);
+        }
+    }
+    bool ok = rc == SQLITE_DONE;
+    if (!ok) err = sqlite3_errmsg(db);
+    {
+        std::lock_guard<std::mutex> l(lock);
+        done = true;
+        changed.notify_all();
+    }
+    for (auto& t : pool) t.join();
+    result.failed = failed;
+    if (ok && failed) {
+        err = std::to_string(failed) + " files could not be written";
+        ok = false;
+    }
+    if (options.progress) options.progress(result, options.user);
+    return ok;
+}
@@ -0,0 +1,36 @@
+// notes_export.h
+// stream the notes table out, oldest first, without ever holding more than a
+// bounded amount of it in memory: rows go from the sqlite3_stmt straight into
+// a chunked writer (JSONL) or a small queue of per-note file writers.
+// both run on the thread that owns db.
+#pragma once
+#include "notes_db.h"
+#include <cstddef>
+#include <string>
+
+struct ExportProgress {
+    size_t notes;   // written so far
+    size_t failed;  // files that could not be written (exportFiles)
+    unsigned long long bytes;
+};
+
+// called on the calling thread every 1000 notes and at the end
+typedef void (*ExportProgressCallback)(const ExportProgress& progress, void* user);
+
+struct ExportOptions {
+    int threads = 0;                          // file writers for exportFiles, 0 = one per core
+    size_t queueBytes = 32u << 20;            // notes read ahead of the file writers
+    ExportProgressCallback progress = nullptr;
+    void* user = nullptr;
+};
+
+// one JSON object per line: {"id":1,"title":"...","content":"..."}.
+// invalid UTF-8 in a note becomes U+FFFD so every line is valid JSON.
+bool exportJsonl(const std::string& file, const ExportOptions& options, ExportProgress& result, std::string& err);
+
+// one file per note in dir (created if needed), named "<id> <title>.txt" with
+// characters Windows does not allow in names replaced; content as stored
+bool exportFiles(const std::string& dir, const ExportOptions& options, ExportProgress& result, std::string& err);
+
+// the JSON string escaping exportJsonl uses (appends to out, with the quotes)
+void appendJsonString(std::string& out, const char* s, size_t n);
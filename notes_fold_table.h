@@ -0,0 +1,401 @@
+// notes_fold_table.h
+// generated, do not edit by hand. foldText (notes_simd.cpp) maps each code
+// point listed here to its text; every other code point folds to itself.
+// the text is the code point in NFKD with combining marks (Mn) dropped, case
+// folded, then NFKD and Mn-stripped once more (Unicode 14.0, Python 3.11):
+//
+//   def strip(s): return ''.join(c for c in s if unicodedata.category(c) != 'Mn')
+//   def fold(ch): return strip(unicodedata.normalize('NFKD', strip(unicodedata.normalize('NFKD', ch)).casefold()))
+//
+// for U+0080..U+05FF (Latin, IPA, Greek, Cyrillic, Armenian, Hebrew), U+1AB0..U+1AFF,
+// U+1D00..U+1FFF, U+20D0..U+20FF, U+FB00..U+FB17, U+FE20..U+FE2F and U+FF00..U+FFEF.
+// scripts whose Mn marks are vowels (Devanagari, Thai, ...) are left out on purpose.
+// entries are sorted by code point; "" drops the code point
+#pragma once
+
+struct FoldEntry {
+    unsigned short cp;
+    const char* folded; // UTF-8
+};
+
+static const FoldEntry kFoldTable[] = {
+    { 0x00A0, " " }, { 0x00A8, " " }, { 0x00AA, "a" }, { 0x00AF, " " }, { 0x00B2, "2" }, { 0x00B3, "3" },
+    { 0x00B4, " " }, { 0x00B5, "\316\274" }, { 0x00B8, " " }, { 0x00B9, "1" }, { 0x00BA, "o" },
+    { 0x00BC, "1\342\201\2044" }, { 0x00BD, "1\342\201\2042" }, { 0x00BE, "3\342\201\2044" }, { 0x00C0, "a" },
+    { 0x00C1, "a" }, { 0x00C2, "a" }, { 0x00C3, "a" }, { 0x00C4, "a" }, { 0x00C5, "a" },
+    { 0x00C6, "\303\246" }, { 0x00C7, "c" }, { 0x00C8, "e" }, { 0x00C9, "e" }, { 0x00CA, "e" },
+    { 0x00CB, "e" }, { 0x00CC, "i" }, { 0x00CD, "i" }, { 0x00CE, "i" }, { 0x00CF, "i" },
+    { 0x00D0, "\303\260" }, { 0x00D1, "n" }, { 0x00D2, "o" }, { 0x00D3, "o" }, { 0x00D4, "o" },
+    { 0x00D5, "o" }, { 0x00D6, "o" }, { 0x00D8, "\303\270" }, { 0x00D9, "u" }, { 0x00DA, "u" },
+    { 0x00DB, "u" }, { 0x00DC, "u" }, { 0x00DD, "y" }, { 0x00DE, "\303\276" }, { 0x00DF, "ss" },
+    { 0x00E0, "a" }, { 0x00E1, "a" }, { 0x00E2, "a" }, { 0x00E3, "a" }, { 0x00E4, "a" }, { 0x00E5, "a" },
+    { 0x00E7, "c" }, { 0x00E8, "e" }, { 0x00E9, "e" }, { 0x00EA, "e" }, { 0x00EB, "e" }, { 0x00EC, "i" },
+    { 0x00ED, "i" }, { 0x00EE, "i" }, { 0x00EF, "i" }, { 0x00F1, "n" }, { 0x00F2, "o" }, { 0x00F3, "o" },
+    { 0x00F4, "o" }, { 0x00F5, "o" }, { 0x00F6, "o" }, { 0x00F9, "u" }, { 0x00FA, "u" }, { 0x00FB, "u" },
+    { 0x00FC, "u" }, { 0x00FD, "y" }, { 0x00FF, "y" }, { 0x0100, "a" }, { 0x0101, "a" }, { 0x0102, "a" },
+    { 0x0103, "a" }, { 0x0104, "a" }, { 0x0105, "a" }, { 0x0106, "c" }, { 0x0107, "c" }, { 0x0108, "c" },
+    { 0x0109, "c" }, { 0x010A, "c" }, { 0x010B, "c" }, { 0x010C, "c" }, { 0x010D, "c" }, { 0x010E, "d" },
+    { 0x010F, "d" }, { 0x0110, "\304\221" }, { 0x0112, "e" }, { 0x0113, "e" }, { 0x0114, "e" },
+    { 0x0115, "e" }, { 0x0116, "e" }, { 0x0117, "e" }, { 0x0118, "e" }, { 0x0119, "e" }, { 0x011A, "e" },
+    { 0x011B, "e" }, { 0x011C, "g" }, { 0x011D, "g" }, { 0x011E, "g" }, { 0x011F, "g" }, { 0x0120, "g" },
+    { 0x0121, "g" }, { 0x0122, "g" }, { 0x0123, "g" }, { 0x0124, "h" }, { 0x0125, "h" },
+    { 0x0126, "\304\247" }, { 0x0128, "i" }, { 0x0129, "i" }, { 0x012A, "i" }, { 0x012B, "i" },
+    { 0x012C, "i" }, { 0x012D, "i" }, { 0x012E, "i" }, { 0x012F, "i" }, { 0x0130, "i" }, { 0x0132, "ij" },
+    { 0x0133, "ij" }, { 0x0134, "j" }, { 0x0135, "j" }, { 0x0136, "k" }, { 0x0137, "k" }, { 0x0139, "l" },
+    { 0x013A, "l" }, { 0x013B, "l" }, { 0x013C, "l" }, { 0x013D, "l" }, { 0x013E, "l" },
+    { 0x013F, "l\302\267" }, { 0x0140, "l\302\267" }, { 0x0141, "\305\202" }, { 0x0143, "n" },
+    { 0x0144, "n" }, { 0x0145, "n" }, { 0x0146, "n" }, { 0x0147, "n" }, { 0x0148, "n" },
+    { 0x0149, "\312\274n" }, { 0x014A, "\305\213" }, { 0x014C, "o" }, { 0x014D, "o" }, { 0x014E, "o" },
+    { 0x014F, "o" }, { 0x0150, "o" }, { 0x0151, "o" }, { 0x0152, "\305\223" }, { 0x0154, "r" },
+    { 0x0155, "r" }, { 0x0156, "r" }, { 0x0157, "r" }, { 0x0158, "r" }, { 0x0159, "r" }, { 0x015A, "s" },
+    { 0x015B, "s" }, { 0x015C, "s" }, { 0x015D, "s" }, { 0x015E, "s" }, { 0x015F, "s" }, { 0x0160, "s" },
+    { 0x0161, "s" }, { 0x0162, "t" }, { 0x0163, "t" }, { 0x0164, "t" }, { 0x0165, "t" },
+    { 0x0166, "\305\247" }, { 0x0168, "u" }, { 0x0169, "u" }, { 0x016A, "u" }, { 0x016B, "u" },
+    { 0x016C, "u" }, { 0x016D, "u" }, { 0x016E, "u" }, { 0x016F, "u" }, { 0x0170, "u" }, { 0x0171, "u" },
+    { 0x0172, "u" }, { 0x0173, "u" }, { 0x0174, "w" }, { 0x0175, "w" }, { 0x0176, "y" }, { 0x0177, "y" },
+    { 0x0178, "y" }, { 0x0179, "z" }, { 0x017A, "z" }, { 0x017B, "z" }, { 0x017C, "z" }, { 0x017D, "z" },
+    { 0x017E, "z" }, { 0x017F, "s" }, { 0x0181, "\311\223" }, { 0x0182, "\306\203" }, { 0x0184, "\306\205" },
+    { 0x0186, "\311\224" }, { 0x0187, "\306\210" }, { 0x0189, "\311\226" }, { 0x018A, "\311\227" },
+    { 0x018B, "\306\214" }, { 0x018E, "\307\235" }, { 0x018F, "\311\231" }, { 0x0190, "\311\233" },
+    { 0x0191, "\306\222" }, { 0x0193, "\311\240" }, { 0x0194, "\311\243" }, { 0x0196, "\311\251" },
+    { 0x0197, "\311\250" }, { 0x0198, "\306\231" }, { 0x019C, "\311\257" }, { 0x019D, "\311\262" },
+    { 0x019F, "\311\265" }, { 0x01A0, "o" }, { 0x01A1, "o" }, { 0x01A2, "\306\243" }, { 0x01A4, "\306\245" },
+    { 0x01A6, "\312\200" }, { 0x01A7, "\306\250" }, { 0x01A9, "\312\203" }, { 0x01AC, "\306\255" },
+    { 0x01AE, "\312\210" }, { 0x01AF, "u" }, { 0x01B0, "u" }, { 0x01B1, "\312\212" }, { 0x01B2, "\312\213" },
+    { 0x01B3, "\306\264" }, { 0x01B5, "\306\266" }, { 0x01B7, "\312\222" }, { 0x01B8, "\306\271" },
+    { 0x01BC, "\306\275" }, { 0x01C4, "dz" }, { 0x01C5, "dz" }, { 0x01C6, "dz" }, { 0x01C7, "lj" },
+    { 0x01C8, "lj" }, { 0x01C9, "lj" }, { 0x01CA, "nj" }, { 0x01CB, "nj" }, { 0x01CC, "nj" }, { 0x01CD, "a" },
+    { 0x01CE, "a" }, { 0x01CF, "i" }, { 0x01D0, "i" }, { 0x01D1, "o" }, { 0x01D2, "o" }, { 0x01D3, "u" },
+    { 0x01D4, "u" }, { 0x01D5, "u" }, { 0x01D6, "u" }, { 0x01D7, "u" }, { 0x01D8, "u" }, { 0x01D9, "u" },
+    { 0x01DA, "u" }, { 0x01DB, "u" }, { 0x01DC, "u" }, { 0x01DE, "a" }, { 0x01DF, "a" }, { 0x01E0, "a" },
+    { 0x01E1, "a" }, { 0x01E2, "\303\246" }, { 0x01E3, "\303\246" }, { 0x01E4, "\307\245" }, { 0x01E6, "g" },
+    { 0x01E7, "g" }, { 0x01E8, "k" }, { 0x01E9, "k" }, { 0x01EA, "o" }, { 0x01EB, "o" }, { 0x01EC, "o" },
+    { 0x01ED, "o" }, { 0x01EE, "\312\222" }, { 0x01EF, "\312\222" }, { 0x01F0, "j" }, { 0x01F1, "dz" },
+    { 0x01F2, "dz" }, { 0x01F3, "dz" }, { 0x01F4, "g" }, { 0x01F5, "g" }, { 0x01F6, "\306\225" },
+    { 0x01F7, "\306\277" }, { 0x01F8, "n" }, { 0x01F9, "n" }, { 0x01FA, "a" }, { 0x01FB, "a" },
+    { 0x01FC, "\303\246" }, { 0x01FD, "\303\246" }, { 0x01FE, "\303\270" }, { 0x01FF, "\303\270" },
+    { 0x0200, "a" }, { 0x0201, "a" }, { 0x0202, "a" }, { 0x0203, "a" }, { 0x0204, "e" }, { 0x0205, "e" },
+    { 0x0206, "e" }, { 0x0207, "e" }, { 0x0208, "i" }, { 0x0209, "i" }, { 0x020A, "i" }, { 0x020B, "i" },
+    { 0x020C, "o" }, { 0x020D, "o" }, { 0x020E, "o" }, { 0x020F, "o" }, { 0x0210, "r" }, { 0x0211, "r" },
+    { 0x0212, "r" }, { 0x0213, "r" }, { 0x0214, "u" }, { 0x0215, "u" }, { 0x0216, "u" }, { 0x0217, "u" },
+    { 0x0218, "s" }, { 0x0219, "s" }, { 0x021A, "t" }, { 0x021B, "t" }, { 0x021C, "\310\235" },
+    { 0x021E, "h" }, { 0x021F, "h" }, { 0x0220, "\306\236" }, { 0x0222, "\310\243" }, { 0x0224, "\310\245" },
+    { 0x0226, "a" }, { 0x0227, "a" }, { 0x0228, "e" }, { 0x0229, "e" }, { 0x022A, "o" }, { 0x022B, "o" },
+    { 0x022C, "o" }, { 0x022D, "o" }, { 0x022E, "o" }, { 0x022F, "o" }, { 0x0230, "o" }, { 0x0231, "o" },
+    { 0x0232, "y" }, { 0x0233, "y" }, { 0x023A, "\342\261\245" }, { 0x023B, "\310\274" },
+    { 0x023D, "\306\232" }, { 0x023E, "\342\261\246" }, { 0x0241, "\311\202" }, { 0x0243, "\306\200" },
+    { 0x0244, "\312\211" }, { 0x0245, "\312\214" }, { 0x0246, "\311\207" }, { 0x0248, "\311\211" },
+    { 0x024A, "\311\213" }, { 0x024C, "\311\215" }, { 0x024E, "\311\217" }, { 0x02B0, "h" },
+    { 0x02B1, "\311\246" }, { 0x02B2, "j" }, { 0x02B3, "r" }, { 0x02B4, "\311\271" }, { 0x02B5, "\311\273" },
+    { 0x02B6, "\312\201" }, { 0x02B7, "w" }, { 0x02B8, "y" }, { 0x02D8, " " }, { 0x02D9, " " },
+    { 0x02DA, " " }, { 0x02DB, " " }, { 0x02DC, " " }, { 0x02DD, " " }, { 0x02E0, "\311\243" },
+    { 0x02E1, "l" }, { 0x02E2, "s" }, { 0x02E3, "x" }, { 0x02E4, "\312\225" }, { 0x0300, "" }, { 0x0301, "" },
+    { 0x0302, "" }, { 0x0303, "" }, { 0x0304, "" }, { 0x0305, "" }, { 0x0306, "" }, { 0x0307, "" },
+    { 0x0308, "" }, { 0x0309, "" }, { 0x030A, "" }, { 0x030B, "" }, { 0x030C, "" }, { 0x030D, "" },
+    { 0x030E, "" }, { 0x030F, "" }, { 0x0310, "" }, { 0x0311, "" }, { 0x0312, "" }, { 0x0313, "" },
+    { 0x0314, "" }, { 0x0315, "" }, { 0x0316, "" }, { 0x0317, "" }, { 0x0318, "" }, { 0x0319, "" },
+    { 0x031A, "" }, { 0x031B, "" }, { 0x031C, "" }, { 0x031D, "" }, { 0x031E, "" }, { 0x031F, "" },
+    { 0x0320, "" }, { 0x0321, "" }, { 0x0322, "" }, { 0x0323, "" }, { 0x0324, "" }, { 0x0325, "" },
+    { 0x0326, "" }, { 0x0327, "" }, { 0x0328, "" }, { 0x0329, "" }, { 0x032A, "" }, { 0x032B, "" },
+    { 0x032C, "" }, { 0x032D, "" }, { 0x032E, "" }, { 0x032F, "" }, { 0x0330, "" }, { 0x0331, "" },
+    { 0x0332, "" }, { 0x0333, "" }, { 0x0334, "" }, { 0x0335, "" }, { 0x0336, "" }, { 0x0337, "" },
+    { 0x0338, "" }, { 0x0339, "" }, { 0x033A, "" }, { 0x033B, "" }, { 0x033C, "" }, { 0x033D, "" },
+    { 0x033E, "" }, { 0x033F, "" }, { 0x0340, "" }, { 0x0341, "" }, { 0x0342, "" }, { 0x0343, "" },
+    { 0x0344, "" }, { 0x0345, "" }, { 0x0346, "" }, { 0x0347, "" }, { 0x0348, "" }, { 0x0349, "" },
+    { 0x034A, "" }, { 0x034B, "" }, { 0x034C, "" }, { 0x034D, "" }, { 0x034E, "" }, { 0x034F, "" },
+    { 0x0350, "" }, { 0x0351, "" }, { 0x0352, "" }, { 0x0353, "" }, { 0x0354, "" }, { 0x0355, "" },
+    { 0x0356, "" }, { 0x0357, "" }, { 0x0358, "" }, { 0x0359, "" }, { 0x035A, "" }, { 0x035B, "" },
+    { 0x035C, "" }, { 0x035D, "" }, { 0x035E, "" }, { 0x035F, "" }, { 0x0360, "" }, { 0x0361, "" },
+    { 0x0362, "" }, { 0x0363, "" }, { 0x0364, "" }, { 0x0365, "" }, { 0x0366, "" }, { 0x0367, "" },
+    { 0x0368, "" }, { 0x0369, "" }, { 0x036A, "" }, { 0x036B, "" }, { 0x036C, "" }, { 0x036D, "" },
+    { 0x036E, "" }, { 0x036F, "" }, { 0x0370, "\315\261" }, { 0x0372, "\315\263" }, { 0x0374, "\312\271" },
+    { 0x0376, "\315\267" }, { 0x037A, " " }, { 0x037E, ";" }, { 0x037F, "\317\263" }, { 0x0384, " " },
+    { 0x0385, " " }, { 0x0386, "\316\261" }, { 0x0387, "\302\267" }, { 0x0388, "\316\265" },
+    { 0x0389, "\316\267" }, { 0x038A, "\316\271" }, { 0x038C, "\316\277" }, { 0x038E, "\317\205" },
+    { 0x038F, "\317\211" }, { 0x0390, "\316\271" }, { 0x0391, "\316\261" }, { 0x0392, "\316\262" },
+    { 0x0393, "\316\263" }, { 0x0394, "\316\264" }, { 0x0395, "\316\265" }, { 0x0396, "\316\266" },
+    { 0x0397, "\316\267" }, { 0x0398, "\316\270" }, { 0x0399, "\316\271" }, { 0x039A, "\316\272" },
+    { 0x039B, "\316\273" }, { 0x039C, "\316\274" }, { 0x039D, "\316\275" }, { 0x039E, "\316\276" },
+    { 0x039F, "\316\277" }, { 0x03A0, "\317\200" }, { 0x03A1, "\317\201" }, { 0x03A3, "\317\203" },
+    { 0x03A4, "\317\204" }, { 0x03A5, "\317\205" }, { 0x03A6, "\317\206" }, { 0x03A7, "\317\207" },
+    { 0x03A8, "\317\210" }, { 0x03A9, "\317\211" }, { 0x03AA, "\316\271" }, { 0x03AB, "\317\205" },
+    { 0x03AC, "\316\261" }, { 0x03AD, "\316\265" }, { 0x03AE, "\316\267" }, { 0x03AF, "\316\271" },
+    { 0x03B0, "\317\205" }, { 0x03C2, "\317\203" }, { 0x03CA, "\316\271" }, { 0x03CB, "\317\205" },
+    { 0x03CC, "\316\277" }, { 0x03CD, "\317\205" }, { 0x03CE, "\317\211" }, { 0x03CF, "\317\227" },
+    { 0x03D0, "\316\262" }, { 0x03D1, "\316\270" }, { 0x03D2, "\317\205" }, { 0x03D3, "\317\205" },
+    { 0x03D4, "\317\205" }, { 0x03D5, "\317\206" }, { 0x03D6, "\317\200" }, { 0x03D8, "\317\231" },
+    { 0x03DA, "\317\233" }, { 0x03DC, "\317\235" }, { 0x03DE, "\317\237" }, { 0x03E0, "\317\241" },
+    { 0x03E2, "\317\243" }, { 0x03E4, "\317\245" }, { 0x03E6, "\317\247" }, { 0x03E8, "\317\251" },
+    { 0x03EA, "\317\253" }, { 0x03EC, "\317\255" }, { 0x03EE, "\317\257" }, { 0x03F0, "\316\272" },
+    { 0x03F1, "\317\201" }, { 0x03F2, "\317\203" }, { 0x03F4, "\316\270" }, { 0x03F5, "\316\265" },
+    { 0x03F7, "\317\270" }, { 0x03F9, "\317\203" }, { 0x03FA, "\317\273" }, { 0x03FD, "\315\273" },
+    { 0x03FE, "\315\274" }, { 0x03FF, "\315\275" }, { 0x0400, "\320\265" }, { 0x0401, "\320\265" },
+    { 0x0402, "\321\222" }, { 0x0403, "\320\263" }, { 0x0404, "\321\224" }, { 0x0405, "\321\225" },
+    { 0x0406, "\321\226" }, { 0x0407, "\321\226" }, { 0x0408, "\321\230" }, { 0x0409, "\321\231" },
+    { 0x040A, "\321\232" }, { 0x040B, "\321\233" }, { 0x040C, "\320\272" }, { 0x040D, "\320\270" },
+    { 0x040E, "\321\203" }, { 0x040F, "\321\237" }, { 0x0410, "\320\260" }, { 0x0411, "\320\261" },
+    { 0x0412, "\320\262" }, { 0x0413, "\320\263" }, { 0x0414, "\320\264" }, { 0x0415, "\320\265" },
+    { 0x0416, "\320\266" }, { 0x0417, "\320\267" }, { 0x0418, "\320\270" }, { 0x0419, "\320\270" },
+    { 0x041A, "\320\272" }, { 0x041B, "\320\273" }, { 0x041C, "\320\274" }, { 0x041D, "\320\275" },
+    { 0x041E, "\320\276" }, { 0x041F, "\320\277" }, { 0x0420, "\321\200" }, { 0x0421, "\321\201" },
+    { 0x0422, "\321\202" }, { 0x0423, "\321\203" }, { 0x0424, "\321\204" }, { 0x0425, "\321\205" },
+    { 0x0426, "\321\206" }, { 0x0427, "\321\207" }, { 0x0428, "\321\210" }, { 0x0429, "\321\211" },
+    { 0x042A, "\321\212" }, { 0x042B, "\321\213" }, { 0x042C, "\321\214" }, { 0x042D, "\321\215" },
+    { 0x042E, "\321\216" }, { 0x042F, "\321\217" }, { 0x0439, "\320\270" }, { 0x0450, "\320\265" },
+    { 0x0451, "\320\265" }, { 0x0453, "\320\263" }, { 0x0457, "\321\226" }, { 0x045C, "\320\272" },
+    { 0x045D, "\320\270" }, { 0x045E, "\321\203" }, { 0x0460, "\321\241" }, { 0x0462, "\321\243" },
+    { 0x0464, "\321\245" }, { 0x0466, "\321\247" }, { 0x0468, "\321\251" }, { 0x046A, "\321\253" },
+    { 0x046C, "\321\255" }, { 0x046E, "\321\257" }, { 0x0470, "\321\261" }, { 0x0472, "\321\263" },
+    { 0x0474, "\321\265" }, { 0x0476, "\321\265" }, { 0x0477, "\321\265" }, { 0x0478, "\321\271" },
+    { 0x047A, "\321\273" }, { 0x047C, "\321\275" }, { 0x047E, "\321\277" }, { 0x0480, "\322\201" },
+    { 0x0483, "" }, { 0x0484, "" }, { 0x0485, "" }, { 0x0486, "" }, { 0x0487, "" }, { 0x048A, "\322\213" },
+    { 0x048C, "\322\215" }, { 0x048E, "\322\217" }, { 0x0490, "\322\221" }, { 0x0492, "\322\223" },
+    { 0x0494, "\322\225" }, { 0x0496, "\322\227" }, { 0x0498, "\322\231" }, { 0x049A, "\322\233" },
+    { 0x049C, "\322\235" }, { 0x049E, "\322\237" }, { 0x04A0, "\322\241" }, { 0x04A2, "\322\243" },
+    { 0x04A4, "\322\245" }, { 0x04A6, "\322\247" }, { 0x04A8, "\322\251" }, { 0x04AA, "\322\253" },
+    { 0x04AC, "\322\255" }, { 0x04AE, "\322\257" }, { 0x04B0, "\322\261" }, { 0x04B2, "\322\263" },
+    { 0x04B4, "\322\265" }, { 0x04B6, "\322\267" }, { 0x04B8, "\322\271" }, { 0x04BA, "\322\273" },
+    { 0x04BC, "\322\275" }, { 0x04BE, "\322\277" }, { 0x04C0, "\323\217" }, { 0x04C1, "\320\266" },
+    { 0x04C2, "\320\266" }, { 0x04C3, "\323\204" }, { 0x04C5, "\323\206" }, { 0x04C7, "\323\210" },
+    { 0x04C9, "\323\212" }, { 0x04CB, "\323\214" }, { 0x04CD, "\323\216" }, { 0x04D0, "\320\260" },
+    { 0x04D1, "\320\260" }, { 0x04D2, "\320\260" }, { 0x04D3, "\320\260" }, { 0x04D4, "\323\225" },
+    { 0x04D6, "\320\265" }, { 0x04D7, "\320\265" }, { 0x04D8, "\323\231" }, { 0x04DA, "\323\231" },
+    { 0x04DB, "\323\231" }, { 0x04DC, "\320\266" }, { 0x04DD, "\320\266" }, { 0x04DE, "\320\267" },
+    { 0x04DF, "\320\267" }, { 0x04E0, "\323\241" }, { 0x04E2, "\320\270" }, { 0x04E3, "\320\270" },
+    { 0x04E4, "\320\270" }, { 0x04E5, "\320\270" }, { 0x04E6, "\320\276" }, { 0x04E7, "\320\276" },
+    { 0x04E8, "\323\251" }, { 0x04EA, "\323\251" }, { 0x04EB, "\323\251" }, { 0x04EC, "\321\215" },
+    { 0x04ED, "\321\215" }, { 0x04EE, "\321\203" }, { 0x04EF, "\321\203" }, { 0x04F0, "\321\203" },
+    { 0x04F1, "\321\203" }, { 0x04F2, "\321\203" }, { 0x04F3, "\321\203" }, { 0x04F4, "\321\207" },
+    { 0x04F5, "\321\207" }, { 0x04F6, "\323\267" }, { 0x04F8, "\321\213" }, { 0x04F9, "\321\213" },
+    { 0x04FA, "\323\273" }, { 0x04FC, "\323\275" }, { 0x04FE, "\323\277" }, { 0x0500, "\324\201" },
+    { 0x0502, "\324\203" }, { 0x0504, "\324\205" }, { 0x0506, "\324\207" }, { 0x0508, "\324\211" },
+    { 0x050A, "\324\213" }, { 0x050C, "\324\215" }, { 0x050E, "\324\217" }, { 0x0510, "\324\221" },
+    { 0x0512, "\324\223" }, { 0x0514, "\324\225" }, { 0x0516, "\324\227" }, { 0x0518, "\324\231" },
+    { 0x051A, "\324\233" }, { 0x051C, "\324\235" }, { 0x051E, "\324\237" }, { 0x0520, "\324\241" },
+    { 0x0522, "\324\243" }, { 0x0524, "\324\245" }, { 0x0526, "\324\247" }, { 0x0528, "\324\251" },
+    { 0x052A, "\324\253" }, { 0x052C, "\324\255" }, { 0x052E, "\324\257" }, { 0x0531, "\325\241" },
+    { 0x0532, "\325\242" }, { 0x0533, "\325\243" }, { 0x0534, "\325\244" }, { 0x0535, "\325\245" },
+    { 0x0536, "\325\246" }, { 0x0537, "\325\247" }, { 0x0538, "\325\250" }, { 0x0539, "\325\251" },
+    { 0x053A, "\325\252" }, { 0x053B, "\325\253" }, { 0x053C, "\325\254" }, { 0x053D, "\325\255" },
+    { 0x053E, "\325\256" }, { 0x053F, "\325\257" }, { 0x0540, "\325\260" }, { 0x0541, "\325\261" },
+    { 0x0542, "\325\262" }, { 0x0543, "\325\263" }, { 0x0544, "\325\264" }, { 0x0545, "\325\265" },
+    { 0x0546, "\325\266" }, { 0x0547, "\325\267" }, { 0x0548, "\325\270" }, { 0x0549, "\325\271" },
+    { 0x054A, "\325\272" }, { 0x054B, "\325\273" }, { 0x054C, "\325\274" }, { 0x054D, "\325\275" },
+    { 0x054E, "\325\276" }, { 0x054F, "\325\277" }, { 0x0550, "\326\200" }, { 0x0551, "\326\201" },
+    { 0x0552, "\326\202" }, { 0x0553, "\326\203" }, { 0x0554, "\326\204" }, { 0x0555, "\326\205" },
+    { 0x0556, "\326\206" }, { 0x0587, "\325\245\326\202" }, { 0x0591, "" }, { 0x0592, "" }, { 0x0593, "" },
+    { 0x0594, "" }, { 0x0595, "" }, { 0x0596, "" }, { 0x0597, "" }, { 0x0598, "" }, { 0x0599, "" },
+    { 0x059A, "" }, { 0x059B, "" }, { 0x059C, "" }, { 0x059D, "" }, { 0x059E, "" }, { 0x059F, "" },
+    { 0x05A0, "" }, { 0x05A1, "" }, { 0x05A2, "" }, { 0x05A3, "" }, { 0x05A4, "" }, { 0x05A5, "" },
+    { 0x05A6, "" }, { 0x05A7, "" }, { 0x05A8, "" }, { 0x05A9, "" }, { 0x05AA, "" }, { 0x05AB, "" },
+    { 0x05AC, "" }, { 0x05AD, "" }, { 0x05AE, "" }, { 0x05AF, "" }, { 0x05B0, "" }, { 0x05B1, "" },
+    { 0x05B2, "" }, { 0x05B3, "" }, { 0x05B4, "" }, { 0x05B5, "" }, { 0x05B6, "" }, { 0x05B7, "" },
+    { 0x05B8, "" }, { 0x05B9, "" }, { 0x05BA, "" }, { 0x05BB, "" }, { 0x05BC, "" }, { 0x05BD, "" },
+    { 0x05BF, "" }, { 0x05C1, "" }, { 0x05C2, "" }, { 0x05C4, "" }, { 0x05C5, "" }, { 0x05C7, "" },
+    { 0x1AB0, "" }, { 0x1AB1, "" }, { 0x1AB2, "" }, { 0x1AB3, "" }, { 0x1AB4, "" }, { 0x1AB5, "" },
+    { 0x1AB6, "" }, { 0x1AB7, "" }, { 0x1AB8, "" }, { 0x1AB9, "" }, { 0x1ABA, "" }, { 0x1ABB, "" },
+    { 0x1ABC, "" }, { 0x1ABD, "" }, { 0x1ABF, "" }, { 0x1AC0, "" }, { 0x1AC1, "" }, { 0x1AC2, "" },
+    { 0x1AC3, "" }, { 0x1AC4, "" }, { 0x1AC5, "" }, { 0x1AC6, "" }, { 0x1AC7, "" }, { 0x1AC8, "" },
+    { 0x1AC9, "" }, { 0x1ACA, "" }, { 0x1ACB, "" }, { 0x1ACC, "" }, { 0x1ACD, "" }, { 0x1ACE, "" },
+    { 0x1D2C, "a" }, { 0x1D2D, "\303\246" }, { 0x1D2E, "b" }, { 0x1D30, "d" }, { 0x1D31, "e" },
+    { 0x1D32, "\307\235" }, { 0x1D33, "g" }, { 0x1D34, "h" }, { 0x1D35, "i" }, { 0x1D36, "j" },
+    { 0x1D37, "k" }, { 0x1D38, "l" }, { 0x1D39, "m" }, { 0x1D3A, "n" }, { 0x1D3C, "o" },
+    { 0x1D3D, "\310\243" }, { 0x1D3E, "p" }, { 0x1D3F, "r" }, { 0x1D40, "t" }, { 0x1D41, "u" },
+    { 0x1D42, "w" }, { 0x1D43, "a" }, { 0x1D44, "\311\220" }, { 0x1D45, "\311\221" },
+    { 0x1D46, "\341\264\202" }, { 0x1D47, "b" }, { 0x1D48, "d" }, { 0x1D49, "e" }, { 0x1D4A, "\311\231" },
+    { 0x1D4B, "\311\233" }, { 0x1D4C, "\311\234" }, { 0x1D4D, "g" }, { 0x1D4F, "k" }, { 0x1D50, "m" },
+    { 0x1D51, "\305\213" }, { 0x1D52, "o" }, { 0x1D53, "\311\224" }, { 0x1D54, "\341\264\226" },
+    { 0x1D55, "\341\264\227" }, { 0x1D56, "p" }, { 0x1D57, "t" }, { 0x1D58, "u" }, { 0x1D59, "\341\264\235" },
+    { 0x1D5A, "\311\257" }, { 0x1D5B, "v" }, { 0x1D5C, "\341\264\245" }, { 0x1D5D, "\316\262" },
+    { 0x1D5E, "\316\263" }, { 0x1D5F, "\316\264" }, { 0x1D60, "\317\206" }, { 0x1D61, "\317\207" },
+    { 0x1D62, "i" }, { 0x1D63, "r" }, { 0x1D64, "u" }, { 0x1D65, "v" }, { 0x1D66, "\316\262" },
+    { 0x1D67, "\316\263" }, { 0x1D68, "\317\201" }, { 0x1D69, "\317\206" }, { 0x1D6A, "\317\207" },
+    { 0x1D78, "\320\275" }, { 0x1D9B, "\311\222" }, { 0x1D9C, "c" }, { 0x1D9D, "\311\225" },
+    { 0x1D9E, "\303\260" }, { 0x1D9F, "\311\234" }, { 0x1DA0, "f" }, { 0x1DA1, "\311\237" },
+    { 0x1DA2, "\311\241" }, { 0x1DA3, "\311\245" }, { 0x1DA4, "\311\250" }, { 0x1DA5, "\311\251" },
+    { 0x1DA6, "\311\252" }, { 0x1DA7, "\341\265\273" }, { 0x1DA8, "\312\235" }, { 0x1DA9, "\311\255" },
+    { 0x1DAA, "\341\266\205" }, { 0x1DAB, "\312\237" }, { 0x1DAC, "\311\261" }, { 0x1DAD, "\311\260" },
+    { 0x1DAE, "\311\262" }, { 0x1DAF, "\311\263" }, { 0x1DB0, "\311\264" }, { 0x1DB1, "\311\265" },
+    { 0x1DB2, "\311\270" }, { 0x1DB3, "\312\202" }, { 0x1DB4, "\312\203" }, { 0x1DB5, "\306\253" },
+    { 0x1DB6, "\312\211" }, { 0x1DB7, "\312\212" }, { 0x1DB8, "\341\264\234" }, { 0x1DB9, "\312\213" },
+    { 0x1DBA, "\312\214" }, { 0x1DBB, "z" }, { 0x1DBC, "\312\220" }, { 0x1DBD, "\312\221" },
+    { 0x1DBE, "\312\222" }, { 0x1DBF, "\316\270" }, { 0x1DC0, "" }, { 0x1DC1, "" }, { 0x1DC2, "" },
+    { 0x1DC3, "" }, { 0x1DC4, "" }, { 0x1DC5, "" }, { 0x1DC6, "" }, { 0x1DC7, "" }, { 0x1DC8, "" },
+    { 0x1DC9, "" }, { 0x1DCA, "" }, { 0x1DCB, "" }, { 0x1DCC, "" }, { 0x1DCD, "" }, { 0x1DCE, "" },
+    { 0x1DCF, "" }, { 0x1DD0, "" }, { 0x1DD1, "" }, { 0x1DD2, "" }, { 0x1DD3, "" }, { 0x1DD4, "" },
+    { 0x1DD5, "" }, { 0x1DD6, "" }, { 0x1DD7, "" }, { 0x1DD8, "" }, { 0x1DD9, "" }, { 0x1DDA, "" },
+    { 0x1DDB, "" }, { 0x1DDC, "" }, { 0x1DDD, "" }, { 0x1DDE, "" }, { 0x1DDF, "" }, { 0x1DE0, "" },
+    { 0x1DE1, "" }, { 0x1DE2, "" }, { 0x1DE3, "" }, { 0x1DE4, "" }, { 0x1DE5, "" }, { 0x1DE6, "" },
+    { 0x1DE7, "" }, { 0x1DE8, "" }, { 0x1DE9, "" }, { 0x1DEA, "" }, { 0x1DEB, "" }, { 0x1DEC, "" },
+    { 0x1DED, "" }, { 0x1DEE, "" }, { 0x1DEF, "" }, { 0x1DF0, "" }, { 0x1DF1, "" }, { 0x1DF2, "" },
+    { 0x1DF3, "" }, { 0x1DF4, "" }, { 0x1DF5, "" }, { 0x1DF6, "" }, { 0x1DF7, "" }, { 0x1DF8, "" },
+    { 0x1DF9, "" }, { 0x1DFA, "" }, { 0x1DFB, "" }, { 0x1DFC, "" }, { 0x1DFD, "" }, { 0x1DFE, "" },
+    { 0x1DFF, "" }, { 0x1E00, "a" }, { 0x1E01, "a" }, { 0x1E02, "b" }, { 0x1E03, "b" }, { 0x1E04, "b" },
+    { 0x1E05, "b" }, { 0x1E06, "b" }, { 0x1E07, "b" }, { 0x1E08, "c" }, { 0x1E09, "c" }, { 0x1E0A, "d" },
+    { 0x1E0B, "d" }, { 0x1E0C, "d" }, { 0x1E0D, "d" }, { 0x1E0E, "d" }, { 0x1E0F, "d" }, { 0x1E10, "d" },
+    { 0x1E11, "d" }, { 0x1E12, "d" }, { 0x1E13, "d" }, { 0x1E14, "e" }, { 0x1E15, "e" }, { 0x1E16, "e" },
+    { 0x1E17, "e" }, { 0x1E18, "e" }, { 0x1E19, "e" }, { 0x1E1A, "e" }, { 0x1E1B, "e" }, { 0x1E1C, "e" },
+    { 0x1E1D, "e" }, { 0x1E1E, "f" }, { 0x1E1F, "f" }, { 0x1E20, "g" }, { 0x1E21, "g" }, { 0x1E22, "h" },
+    { 0x1E23, "h" }, { 0x1E24, "h" }, { 0x1E25, "h" }, { 0x1E26, "h" }, { 0x1E27, "h" }, { 0x1E28, "h" },
+    { 0x1E29, "h" }, { 0x1E2A, "h" }, { 0x1E2B, "h" }, { 0x1E2C, "i" }, { 0x1E2D, "i" }, { 0x1E2E, "i" },
+    { 0x1E2F, "i" }, { 0x1E30, "k" }, { 0x1E31, "k" }, { 0x1E32, "k" }, { 0x1E33, "k" }, { 0x1E34, "k" },
+    { 0x1E35, "k" }, { 0x1E36, "l" }, { 0x1E37, "l" }, { 0x1E38, "l" }, { 0x1E39, "l" }, { 0x1E3A, "l" },
+    { 0x1E3B, "l" }, { 0x1E3C, "l" }, { 0x1E3D, "l" }, { 0x1E3E, "m" }, { 0x1E3F, "m" }, { 0x1E40, "m" },
+    { 0x1E41, "m" }, { 0x1E42, "m" }, { 0x1E43, "m" }, { 0x1E44, "n" }, { 0x1E45, "n" }, { 0x1E46, "n" },
+    { 0x1E47, "n" }, { 0x1E48, "n" }, { 0x1E49, "n" }, { 0x1E4A, "n" }, { 0x1E4B, "n" }, { 0x1E4C, "o" },
+    { 0x1E4D, "o" }, { 0x1E4E, "o" }, { 0x1E4F, "o" }, { 0x1E50, "o" }, { 0x1E51, "o" }, { 0x1E52, "o" },
+    { 0x1E53, "o" }, { 0x1E54, "p" }, { 0x1E55, "p" }, { 0x1E56, "p" }, { 0x1E57, "p" }, { 0x1E58, "r" },
+    { 0x1E59, "r" }, { 0x1E5A, "r" }, { 0x1E5B, "r" }, { 0x1E5C, "r" }, { 0x1E5D, "r" }, { 0x1E5E, "r" },
+    { 0x1E5F, "r" }, { 0x1E60, "s" }, { 0x1E61, "s" }, { 0x1E62, "s" }, { 0x1E63, "s" }, { 0x1E64, "s" },
+    { 0x1E65, "s" }, { 0x1E66, "s" }, { 0x1E67, "s" }, { 0x1E68, "s" }, { 0x1E69, "s" }, { 0x1E6A, "t" },
+    { 0x1E6B, "t" }, { 0x1E6C, "t" }, { 0x1E6D, "t" }, { 0x1E6E, "t" }, { 0x1E6F, "t" }, { 0x1E70, "t" },
+    { 0x1E71, "t" }, { 0x1E72, "u" }, { 0x1E73, "u" }, { 0x1E74, "u" }, { 0x1E75, "u" }, { 0x1E76, "u" },
+    { 0x1E77, "u" }, { 0x1E78, "u" }, { 0x1E79, "u" }, { 0x1E7A, "u" }, { 0x1E7B, "u" }, { 0x1E7C, "v" },
+    { 0x1E7D, "v" }, { 0x1E7E, "v" }, { 0x1E7F, "v" }, { 0x1E80, "w" }, { 0x1E81, "w" }, { 0x1E82, "w" },
+    { 0x1E83, "w" }, { 0x1E84, "w" }, { 0x1E85, "w" }, { 0x1E86, "w" }, { 0x1E87, "w" }, { 0x1E88, "w" },
+    { 0x1E89, "w" }, { 0x1E8A, "x" }, { 0x1E8B, "x" }, { 0x1E8C, "x" }, { 0x1E8D, "x" }, { 0x1E8E, "y" },
+    { 0x1E8F, "y" }, { 0x1E90, "z" }, { 0x1E91, "z" }, { 0x1E92, "z" }, { 0x1E93, "z" }, { 0x1E94, "z" },
+    { 0x1E95, "z" }, { 0x1E96, "h" }, { 0x1E97, "t" }, { 0x1E98, "w" }, { 0x1E99, "y" },
+    { 0x1E9A, "a\312\276" }, { 0x1E9B, "s" }, { 0x1E9E, "ss" }, { 0x1EA0, "a" }, { 0x1EA1, "a" },
+    { 0x1EA2, "a" }, { 0x1EA3, "a" }, { 0x1EA4, "a" }, { 0x1EA5, "a" }, { 0x1EA6, "a" }, { 0x1EA7, "a" },
+    { 0x1EA8, "a" }, { 0x1EA9, "a" }, { 0x1EAA, "a" }, { 0x1EAB, "a" }, { 0x1EAC, "a" }, { 0x1EAD, "a" },
+    { 0x1EAE, "a" }, { 0x1EAF, "a" }, { 0x1EB0, "a" }, { 0x1EB1, "a" }, { 0x1EB2, "a" }, { 0x1EB3, "a" },
+    { 0x1EB4, "a" }, { 0x1EB5, "a" }, { 0x1EB6, "a" }, { 0x1EB7, "a" }, { 0x1EB8, "e" }, { 0x1EB9, "e" },
+    { 0x1EBA, "e" }, { 0x1EBB, "e" }, { 0x1EBC, "e" }, { 0x1EBD, "e" }, { 0x1EBE, "e" }, { 0x1EBF, "e" },
+    { 0x1EC0, "e" }, { 0x1EC1, "e" }, { 0x1EC2, "e" }, { 0x1EC3, "e" }, { 0x1EC4, "e" }, { 0x1EC5, "e" },
+    { 0x1EC6, "e" }, { 0x1EC7, "e" }, { 0x1EC8, "i" }, { 0x1EC9, "i" }, { 0x1ECA, "i" }, { 0x1ECB, "i" },
+    { 0x1ECC, "o" }, { 0x1ECD, "o" }, { 0x1ECE, "o" }, { 0x1ECF, "o" }, { 0x1ED0, "o" }, { 0x1ED1, "o" },
+    { 0x1ED2, "o" }, { 0x1ED3, "o" }, { 0x1ED4, "o" }, { 0x1ED5, "o" }, { 0x1ED6, "o" }, { 0x1ED7, "o" },
+    { 0x1ED8, "o" }, { 0x1ED9, "o" }, { 0x1EDA, "o" }, { 0x1EDB, "o" }, { 0x1EDC, "o" }, { 0x1EDD, "o" },
+    { 0x1EDE, "o" }, { 0x1EDF, "o" }, { 0x1EE0, "o" }, { 0x1EE1, "o" }, { 0x1EE2, "o" }, { 0x1EE3, "o" },
+    { 0x1EE4, "u" }, { 0x1EE5, "u" }, { 0x1EE6, "u" }, { 0x1EE7, "u" }, { 0x1EE8, "u" }, { 0x1EE9, "u" },
+    { 0x1EEA, "u" }, { 0x1EEB, "u" }, { 0x1EEC, "u" }, { 0x1EED, "u" }, { 0x1EEE, "u" }, { 0x1EEF, "u" },
+    { 0x1EF0, "u" }, { 0x1EF1, "u" }, { 0x1EF2, "y" }, { 0x1EF3, "y" }, { 0x1EF4, "y" }, { 0x1EF5, "y" },
+    { 0x1EF6, "y" }, { 0x1EF7, "y" }, { 0x1EF8, "y" }, { 0x1EF9, "y" }, { 0x1EFA, "\341\273\273" },
+    { 0x1EFC, "\341\273\275" }, { 0x1EFE, "\341\273\277" }, { 0x1F00, "\316\261" }, { 0x1F01, "\316\261" },
+    { 0x1F02, "\316\261" }, { 0x1F03, "\316\261" }, { 0x1F04, "\316\261" }, { 0x1F05, "\316\261" },
+    { 0x1F06, "\316\261" }, { 0x1F07, "\316\261" }, { 0x1F08, "\316\261" }, { 0x1F09, "\316\261" },
+    { 0x1F0A, "\316\261" }, { 0x1F0B, "\316\261" }, { 0x1F0C, "\316\261" }, { 0x1F0D, "\316\261" },
+    { 0x1F0E, "\316\261" }, { 0x1F0F, "\316\261" }, { 0x1F10, "\316\265" }, { 0x1F11, "\316\265" },
+    { 0x1F12, "\316\265" }, { 0x1F13, "\316\265" }, { 0x1F14, "\316\265" }, { 0x1F15, "\316\265" },
+    { 0x1F18, "\316\265" }, { 0x1F19, "\316\265" }, { 0x1F1A, "\316\265" }, { 0x1F1B, "\316\265" },
+    { 0x1F1C, "\316\265" }, { 0x1F1D, "\316\265" }, { 0x1F20, "\316\267" }, { 0x1F21, "\316\267" },
+    { 0x1F22, "\316\267" }, { 0x1F23, "\316\267" }, { 0x1F24, "\316\267" }, { 0x1F25, "\316\267" },
+    { 0x1F26, "\316\267" }, { 0x1F27, "\316\267" }, { 0x1F28, "\316\267" }, { 0x1F29, "\316\267" },
+    { 0x1F2A, "\316\267" }, { 0x1F2B, "\316\267" }, { 0x1F2C, "\316\267" }, { 0x1F2D, "\316\267" },
+    { 0x1F2E, "\316\267" }, { 0x1F2F, "\316\267" }, { 0x1F30, "\316\271" }, { 0x1F31, "\316\271" },
+    { 0x1F32, "\316\271" }, { 0x1F33, "\316\271" }, { 0x1F34, "\316\271" }, { 0x1F35, "\316\271" },
+    { 0x1F36, "\316\271" }, { 0x1F37, "\316\271" }, { 0x1F38, "\316\271" }, { 0x1F39, "\316\271" },
+    { 0x1F3A, "\316\271" }, { 0x1F3B, "\316\271" }, { 0x1F3C, "\316\271" }, { 0x1F3D, "\316\271" },
+    { 0x1F3E, "\316\271" }, { 0x1F3F, "\316\271" }, { 0x1F40, "\316\277" }, { 0x1F41, "\316\277" },
+    { 0x1F42, "\316\277" }, { 0x1F43, "\316\277" }, { 0x1F44, "\316\277" }, { 0x1F45, "\316\277" },
+    { 0x1F48, "\316\277" }, { 0x1F49, "\316\277" }, { 0x1F4A, "\316\277" }, { 0x1F4B, "\316\277" },
+    { 0x1F4C, "\316\277" }, { 0x1F4D, "\316\277" }, { 0x1F50, "\317\205" }, { 0x1F51, "\317\205" },
+    { 0x1F52, "\317\205" }, { 0x1F53, "\317\205" }, { 0x1F54, "\317\205" }, { 0x1F55, "\317\205" },
+    { 0x1F56, "\317\205" }, { 0x1F57, "\317\205" }, { 0x1F59, "\317\205" }, { 0x1F5B, "\317\205" },
+    { 0x1F5D, "\317\205" }, { 0x1F5F, "\317\205" }, { 0x1F60, "\317\211" }, { 0x1F61, "\317\211" },
+    { 0x1F62, "\317\211" }, { 0x1F63, "\317\211" }, { 0x1F64, "\317\211" }, { 0x1F65, "\317\211" },
+    { 0x1F66, "\317\211" }, { 0x1F67, "\317\211" }, { 0x1F68, "\317\211" }, { 0x1F69, "\317\211" },
+    { 0x1F6A, "\317\211" }, { 0x1F6B, "\317\211" }, { 0x1F6C, "\317\211" }, { 0x1F6D, "\317\211" },
+    { 0x1F6E, "\317\211" }, { 0x1F6F, "\317\211" }, { 0x1F70, "\316\261" }, { 0x1F71, "\316\261" },
+    { 0x1F72, "\316\265" }, { 0x1F73, "\316\265" }, { 0x1F74, "\316\267" }, { 0x1F75, "\316\267" },
+    { 0x1F76, "\316\271" }, { 0x1F77, "\316\271" }, { 0x1F78, "\316\277" }, { 0x1F79, "\316\277" },
+    { 0x1F7A, "\317\205" }, { 0x1F7B, "\317\205" }, { 0x1F7C, "\317\211" }, { 0x1F7D, "\317\211" },
+    { 0x1F80, "\316\261" }, { 0x1F81, "\316\261" }, { 0x1F82, "\316\261" }, { 0x1F83, "\316\261" },
+    { 0x1F84, "\316\261" }, { 0x1F85, "\316\261" }, { 0x1F86, "\316\261" }, { 0x1F87, "\316\261" },
+    { 0x1F88, "\316\261" }, { 0x1F89, "\316\261" }, { 0x1F8A, "\316\261" }, { 0x1F8B, "\316\261" },
+    { 0x1F8C, "\316\261" }, { 0x1F8D, "\316\261" }, { 0x1F8E, "\316\261" }, { 0x1F8F, "\316\261" },
+    { 0x1F90, "\316\267" }, { 0x1F91, "\316\267" }, { 0x1F92, "\316\267" }, { 0x1F93, "\316\267" },
+    { 0x1F94, "\316\267" }, { 0x1F95, "\316\267" }, { 0x1F96, "\316\267" }, { 0x1F97, "\316\267" },
+    { 0x1F98, "\316\267" }, { 0x1F99, "\316\267" }, { 0x1F9A, "\316\267" }, { 0x1F9B, "\316\267" },
+    { 0x1F9C, "\316\267" }, { 0x1F9D, "\316\267" }, { 0x1F9E, "\316\267" }, { 0x1F9F, "\316\267" },
+    { 0x1FA0, "\317\211" }, { 0x1FA1, "\317\211" }, { 0x1FA2, "\317\211" }, { 0x1FA3, "\317\211" },
+    { 0x1FA4, "\317\211" }, { 0x1FA5, "\317\211" }, { 0x1FA6, "\317\211" }, { 0x1FA7, "\317\211" },
+    { 0x1FA8, "\317\211" }, { 0x1FA9, "\317\211" }, { 0x1FAA, "\317\211" }, { 0x1FAB, "\317\211" },
+    { 0x1FAC, "\317\211" }, { 0x1FAD, "\317\211" }, { 0x1FAE, "\317\211" }, { 0x1FAF, "\317\211" },
+    { 0x1FB0, "\316\261" }, { 0x1FB1, "\316\261" }, { 0x1FB2, "\316\261" }, { 0x1FB3, "\316\261" },
+    { 0x1FB4, "\316\261" }, { 0x1FB6, "\316\261" }, { 0x1FB7, "\316\261" }, { 0x1FB8, "\316\261" },
+    { 0x1FB9, "\316\261" }, { 0x1FBA, "\316\261" }, { 0x1FBB, "\316\261" }, { 0x1FBC, "\316\261" },
+    { 0x1FBD, " " }, { 0x1FBE, "\316\271" }, { 0x1FBF, " " }, { 0x1FC0, " " }, { 0x1FC1, " " },
+    { 0x1FC2, "\316\267" }, { 0x1FC3, "\316\267" }, { 0x1FC4, "\316\267" }, { 0x1FC6, "\316\267" },
+    { 0x1FC7, "\316\267" }, { 0x1FC8, "\316\265" }, { 0x1FC9, "\316\265" }, { 0x1FCA, "\316\267" },
+    { 0x1FCB, "\316\267" }, { 0x1FCC, "\316\267" }, { 0x1FCD, " " }, { 0x1FCE, " " }, { 0x1FCF, " " },
+    { 0x1FD0, "\316\271" }, { 0x1FD1, "\316\271" }, { 0x1FD2, "\316\271" }, { 0x1FD3, "\316\271" },
+    { 0x1FD6, "\316\271" }, { 0x1FD7, "\316\271" }, { 0x1FD8, "\316\271" }, { 0x1FD9, "\316\271" },
+    { 0x1FDA, "\316\271" }, { 0x1FDB, "\316\271" }, { 0x1FDD, " " }, { 0x1FDE, " " }, { 0x1FDF, " " },
+    { 0x1FE0, "\317\205" }, { 0x1FE1, "\317\205" }, { 0x1FE2, "\317\205" }, { 0x1FE3, "\317\205" },
+    { 0x1FE4, "\317\201" }, { 0x1FE5, "\317\201" }, { 0x1FE6, "\317\205" }, { 0x1FE7, "\317\205" },
+    { 0x1FE8, "\317\205" }, { 0x1FE9, "\317\205" }, { 0x1FEA, "\317\205" }, { 0x1FEB, "\317\205" },
+    { 0x1FEC, "\317\201" }, { 0x1FED, " " }, { 0x1FEE, " " }, { 0x1FEF, "`" }, { 0x1FF2, "\317\211" },
+    { 0x1FF3, "\317\211" }, { 0x1FF4, "\317\211" }, { 0x1FF6, "\317\211" }, { 0x1FF7, "\317\211" },
+    { 0x1FF8, "\316\277" }, { 0x1FF9, "\316\277" }, { 0x1FFA, "\317\211" }, { 0x1FFB, "\317\211" },
+    { 0x1FFC, "\317\211" }, { 0x1FFD, " " }, { 0x1FFE, " " }, { 0x20D0, "" }, { 0x20D1, "" }, { 0x20D2, "" },
+    { 0x20D3, "" }, { 0x20D4, "" }, { 0x20D5, "" }, { 0x20D6, "" }, { 0x20D7, "" }, { 0x20D8, "" },
+    { 0x20D9, "" }, { 0x20DA, "" }, { 0x20DB, "" }, { 0x20DC, "" }, { 0x20E1, "" }, { 0x20E5, "" },
+    { 0x20E6, "" }, { 0x20E7, "" }, { 0x20E8, "" }, { 0x20E9, "" }, { 0x20EA, "" }, { 0x20EB, "" },
+    { 0x20EC, "" }, { 0x20ED, "" }, { 0x20EE, "" }, { 0x20EF, "" }, { 0x20F0, "" }, { 0xFB00, "ff" },
+    { 0xFB01, "fi" }, { 0xFB02, "fl" }, { 0xFB03, "ffi" }, { 0xFB04, "ffl" }, { 0xFB05, "st" },
+    { 0xFB06, "st" }, { 0xFB13, "\325\264\325\266" }, { 0xFB14, "\325\264\325\245" },
+    { 0xFB15, "\325\264\325\253" }, { 0xFB16, "\325\276\325\266" }, { 0xFB17, "\325\264\325\255" },
+    { 0xFE20, "" }, { 0xFE21, "" }, { 0xFE22, "" }, { 0xFE23, "" }, { 0xFE24, "" }, { 0xFE25, "" },
+    { 0xFE26, "" }, { 0xFE27, "" }, { 0xFE28, "" }, { 0xFE29, "" }, { 0xFE2A, "" }, { 0xFE2B, "" },
+    { 0xFE2C, "" }, { 0xFE2D, "" }, { 0xFE2E, "" }, { 0xFE2F, "" }, { 0xFF01, "!" }, { 0xFF02, "\042" },
+    { 0xFF03, "#" }, { 0xFF04, "$" }, { 0xFF05, "%" }, { 0xFF06, "&" }, { 0xFF07, "'" }, { 0xFF08, "(" },
+    { 0xFF09, ")" }, { 0xFF0A, "*" }, { 0xFF0B, "+" }, { 0xFF0C, "," }, { 0xFF0D, "-" }, { 0xFF0E, "." },
+    { 0xFF0F, "/" }, { 0xFF10, "0" }, { 0xFF11, "1" }, { 0xFF12, "2" }, { 0xFF13, "3" }, { 0xFF14, "4" },
+    { 0xFF15, "5" }, { 0xFF16, "6" }, { 0xFF17, "7" }, { 0xFF18, "8" }, { 0xFF19, "9" }, { 0xFF1A, ":" },
+    { 0xFF1B, ";" }, { 0xFF1C, "<" }, { 0xFF1D, "=" }, { 0xFF1E, ">" }, { 0xFF1F, "\077" }, { 0xFF20, "@" },
+    { 0xFF21, "a" }, { 0xFF22, "b" }, { 0xFF23, "c" }, { 0xFF24, "d" }, { 0xFF25, "e" }, { 0xFF26, "f" },
+    { 0xFF27, "g" }, { 0xFF28, "h" }, { 0xFF29, "i" }, { 0xFF2A, "j" }, { 0xFF2B, "k" }, { 0xFF2C, "l" },
+    { 0xFF2D, "m" }, { 0xFF2E, "n" }, { 0xFF2F, "o" }, { 0xFF30, "p" }, { 0xFF31, "q" }, { 0xFF32, "r" },
+    { 0xFF33, "s" }, { 0xFF34, "t" }, { 0xFF35, "u" }, { 0xFF36, "v" }, { 0xFF37, "w" }, { 0xFF38, "x" },
+    { 0xFF39, "y" }, { 0xFF3A, "z" }, { 0xFF3B, "[" }, { 0xFF3C, "\134" }, { 0xFF3D, "]" }, { 0xFF3E, "^" },
+    { 0xFF3F, "_" }, { 0xFF40, "`" }, { 0xFF41, "a" }, { 0xFF42, "b" }, { 0xFF43, "c" }, { 0xFF44, "d" },
+    { 0xFF45, "e" }, { 0xFF46, "f" }, { 0xFF47, "g" }, { 0xFF48, "h" }, { 0xFF49, "i" }, { 0xFF4A, "j" },
+    { 0xFF4B, "k" }, { 0xFF4C, "l" }, { 0xFF4D, "m" }, { 0xFF4E, "n" }, { 0xFF4F, "o" }, { 0xFF50, "p" },
+    { 0xFF51, "q" }, { 0xFF52, "r" }, { 0xFF53, "s" }, { 0xFF54, "t" }, { 0xFF55, "u" }, { 0xFF56, "v" },
+    { 0xFF57, "w" }, { 0xFF58, "x" }, { 0xFF59, "y" }, { 0xFF5A, "z" }, { 0xFF5B, "{" }, { 0xFF5C, "|" },
+    { 0xFF5D, "}" }, { 0xFF5E, "~" }, { 0xFF5F, "\342\246\205" }, { 0xFF60, "\342\246\206" },
+    { 0xFF61, "\343\200\202" }, { 0xFF62, "\343\200\214" }, { 0xFF63, "\343\200\215" },
+    { 0xFF64, "\343\200\201" }, { 0xFF65, "\343\203\273" }, { 0xFF66, "\343\203\262" },
+    { 0xFF67, "\343\202\241" }, { 0xFF68, "\343\202\243" }, { 0xFF69, "\343\202\245" },
+    { 0xFF6A, "\343\202\247" }, { 0xFF6B, "\343\202\251" }, { 0xFF6C, "\343\203\243" },
+    { 0xFF6D, "\343\203\245" }, { 0xFF6E, "\343\203\247" }, { 0xFF6F, "\343\203\203" },
+    { 0xFF70, "\343\203\274" }, { 0xFF71, "\343\202\242" }, { 0xFF72, "\343\202\244" },
+    { 0xFF73, "\343\202\246" }, { 0xFF74, "\343\202\250" }, { 0xFF75, "\343\202\252" },
+    { 0xFF76, "\343\202\253" }, { 0xFF77, "\343\202\255" }, { 0xFF78, "\343\202\257" },
+    { 0xFF79, "\343\202\261" }, { 0xFF7A, "\343\202\263" }, { 0xFF7B, "\343\202\265" },
+    { 0xFF7C, "\343\202\267" }, { 0xFF7D, "\343\202\271" }, { 0xFF7E, "\343\202\273" },
+    { 0xFF7F, "\343\202\275" }, { 0xFF80, "\343\202\277" }, { 0xFF81, "\343\203\201" },
+    { 0xFF82, "\343\203\204" }, { 0xFF83, "\343\203\206" }, { 0xFF84, "\343\203\210" },
+    { 0xFF85, "\343\203\212" }, { 0xFF86, "\343\203\213" }, { 0xFF87, "\343\203\214" },
+    { 0xFF88, "\343\203\215" }, { 0xFF89, "\343\203\216" }, { 0xFF8A, "\343\203\217" },
+    { 0xFF8B, "\343\203\222" }, { 0xFF8C, "\343\203\225" }, { 0xFF8D, "\343\203\230" },
+    { 0xFF8E, "\343\203\233" }, { 0xFF8F, "\343\203\236" }, { 0xFF90, "\343\203\237" },
+    { 0xFF91, "\343\203\240" }, { 0xFF92, "\343\203\241" }, { 0xFF93, "\343\203\242" },
+    { 0xFF94, "\343\203\244" }, { 0xFF95, "\343\203\246" }, { 0xFF96, "\343\203\250" },
+    { 0xFF97, "\343\203\251" }, { 0xFF98, "\343\203\252" }, { 0xFF99, "\343\203\253" },
+    { 0xFF9A, "\343\203\254" }, { 0xFF9B, "\343\203\255" }, { 0xFF9C, "\343\203\257" },
+    { 0xFF9D, "\343\203\263" }, { 0xFF9E, "" }, { 0xFF9F, "" }, { 0xFFA0, "\341\205\240" },
+    { 0xFFA1, "\341\204\200" }, { 0xFFA2, "\341\204\201" }, { 0xFFA3, "\341\206\252" },
+    { 0xFFA4, "\341\204\202" }, { 0xFFA5, "\341\206\254" }, { 0xFFA6, "\341\206\255" },
+    { 0xFFA7, "\341\204\203" }, { 0xFFA8, "\341\204\204" }, { 0xFFA9, "\341\204\205" },
+    { 0xFFAA, "\341\206\260" }, { 0xFFAB, "\341\206\261" }, { 0xFFAC, "\341\206\262" },
+    { 0xFFAD, "\341\206\263" }, { 0xFFAE, "\341\206\264" }, { 0xFFAF, "\341\206\265" },
+    { 0xFFB0, "\341\204\232" }, { 0xFFB1, "\341\204\206" }, { 0xFFB2, "\341\204\207" },
+    { 0xFFB3, "\341\204\210" }, { 0xFFB4, "\341\204\241" }, { 0xFFB5, "\341\204\211" },
+    { 0xFFB6, "\341\204\212" }, { 0xFFB7, "\341\204\213" }, { 0xFFB8, "\341\204\214" },
+    { 0xFFB9, "\341\204\215" }, { 0xFFBA, "\341\204\216" }, { 0xFFBB, "\341\204\217" },
+    { 0xFFBC, "\341\204\220" }, { 0xFFBD, "\341\204\221" }, { 0xFFBE, "\341\204\222" },
+    { 0xFFC2, "\341\205\241" }, { 0xFFC3, "\341\205\242" }, { 0xFFC4, "\341\205\243" },
+    { 0xFFC5, "\341\205\244" }, { 0xFFC6, "\341\205\245" }, { 0xFFC7, "\341\205\246" },
+    { 0xFFCA, "\341\205\247" }, { 0xFFCB, "\341\205\250" }, { 0xFFCC, "\341\205\251" },
+    { 0xFFCD, "\341\205\252" }, { 0xFFCE, "\341\205\253" }, { 0xFFCF, "\341\205\254" },
+    { 0xFFD2, "\341\205\255" }, { 0xFFD3, "\341\205\256" }, { 0xFFD4, "\341\205\257" },
+    { 0xFFD5, "\341\205\260" }, { 0xFFD6, "\341\205\261" }, { 0xFFD7, "\341\205\262" },
+    { 0xFFDA, "\341\205\263" }, { 0xFFDB, "\341\205\264" }, { 0xFFDC, "\341\205\265" },
+    { 0xFFE0, "\302\242" }, { 0xFFE1, "\302\243" }, { 0xFFE2, "\302\254" }, { 0xFFE3, " " },
+    { 0xFFE4, "\302\246" }, { 0xFFE5, "\302\245" }, { 0xFFE6, "\342\202\251" }, { 0xFFE8, "\342\224\202" },
+    { 0xFFE9, "\342\206\220" }, { 0xFFEA, "\342\206\221" }, { 0xFFEB, "\342\206\222" },
+    { 0xFFEC, "\342\206\223" }, { 0xFFED, "\342\226\240" }, { 0xFFEE, "\342\227\213" },
+};
@@ -0,0 +1,379 @@
+// notes_fts.cpp
+// FTS5 shadow indexes over notes, kept in sync by triggers:
+//   notes_fts     unicode61 words, for prefix queries and bm25 ranking
+//   notes_trigram trigram tokens of the folded column, for substring search
+//                 (the Like scan's semantics: case and diacritics ignored)
+// both are external-content tables, so the text is only stored once in notes.
+#include "notes_simd.h"
+#include "notes_internal.h"
+#include "notes_trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+static std::atomic<SearchMode> g_searchMode(SearchMode::Substring);
+static std::atomic<bool> g_ftsAvailable(false);
+static std::atomic<bool> g_ftsReady(false);
+
+static std::thread g_backfillThread;
+static std::atomic<sqlite3*> g_backfillDb(nullptr);
+
+// rows of a bulk insert that are not indexed yet (see deferIndexing): the
+// triggers leave them alone, the catch-up indexes them with their text of then
+#define NOT_PENDING(ID) \
+    " NOT EXISTS (SELECT 1 FROM notes_fts_pending WHERE " ID " >= first AND (last IS NULL OR " ID " <= last))"
+
+static const char* kSqlFtsSchema =
+    "CREATE VIRTUAL TABLE IF NOT EXISTS notes_fts USING fts5("
+    "  title, content, content='notes', content_rowid='id');"
+    // the text is folded already; trigram's own case folding would differ for some scripts
+    "CREATE VIRTUAL TABLE IF NOT EXISTS notes_trigram USING fts5("
+    "  folded, content='notes', content_rowid='id', tokenize='trigram case_sensitive 1');"
+    "CREATE TABLE IF NOT EXISTS notes_fts_pending (first INTEGER, last INTEGER);"
+    "DROP TRIGGER IF EXISTS notes_fts_ai;"
+    "CREATE TRIGGER notes_fts_ai AFTER INSERT ON notes WHEN" NOT_PENDING("new.id") " BEGIN"
+    "  INSERT INTO notes_fts(rowid, title, content) VALUES (new.id, new.title, new.content);"
+    "  INSERT INTO notes_trigram(rowid, folded) VALUES (new.id, new.folded);"
+    "END;"
+    "DROP TRIGGER IF EXISTS notes_fts_ad;"
+    "CREATE TRIGGER notes_fts_ad AFTER DELETE ON notes WHEN" NOT_PENDING("old.id") " BEGIN"
+    "  INSERT INTO notes_fts(notes_fts, rowid, title, content) VALUES ('delete', old.id, old.title, old.content);"
+    "  INSERT INTO notes_trigram(notes_trigram, rowid, folded) VALUES ('delete', old.id, old.folded);"
+    "END;"
+    // only text edits touch the index (not e.g. the preview backfill). one
+    // trigger per index, each on its own columns: notes_refold (notes_db.cpp)
+    // updates folded from inside an edit of title or content, and in whatever
+    // order the triggers run, each index then drops exactly what it holds
+    "DROP TRIGGER IF EXISTS notes_fts_au;"
+    "CREATE TRIGGER notes_fts_au AFTER UPDATE OF title, content ON notes WHEN" NOT_PENDING("old.id") " BEGIN"
+    "  INSERT INTO notes_fts(notes_fts, rowid, title, content) VALUES ('delete', old.id, old.title, old.content);"
+    "  INSERT INTO notes_fts(rowid, title, content) VALUES (new.id, new.title, new.content);"
+    "END;"
+    "DROP TRIGGER IF EXISTS notes_trigram_au;"
+    "CREATE TRIGGER notes_trigram_au AFTER UPDATE OF folded ON notes WHEN" NOT_PENDING("old.id") " BEGIN"
+    "  INSERT INTO notes_trigram(notes_trigram, rowid, folded) VALUES ('delete', old.id, old.folded);"
+    "  INSERT INTO notes_trigram(rowid, folded) VALUES (new.id, new.folded);"
+    "END;";
+
+// notes_meta fts_version: 2 = notes_trigram over the folded column (1 indexed title, content)
+#define FTS_VERSION "2"
+
+// rebuild both indexes from notes and mark them done, in one transaction
+static const char* kSqlFtsRebuild =
+    "BEGIN IMMEDIATE;"
+    "INSERT INTO notes_fts(notes_fts) VALUES ('rebuild');"
+    "INSERT INTO notes_trigram(notes_trigram) VALUES ('rebuild');"
+    "DELETE FROM notes_fts_pending;"
+    "INSERT OR REPLACE INTO notes_meta (key, value) VALUES ('fts_version', '" FTS_VERSION "');"
+    "COMMIT;";
+
+// index the next CATCH_UP_ROWS ids of the oldest pending range and take them
+// off it, one transaction per chunk so writers never wait for a whole bulk load
+#define CATCH_UP_ROWS "2000"
+#define CATCH_UP_CHUNK \
+    " (SELECT first, min(last, first + " CATCH_UP_ROWS " - 1) AS upto FROM notes_fts_pending" \
+    "  WHERE last IS NOT NULL ORDER BY first LIMIT 1) c"
+static const char* kSqlFtsCatchUp =
+    "BEGIN IMMEDIATE;"
+    "INSERT INTO notes_fts(rowid, title, content) "
+    "  SELECT n.id, n.title, n.content FROM" CATCH_UP_CHUNK " JOIN notes n ON n.id BETWEEN c.first AND c.upto;"
+    "INSERT INTO notes_trigram(rowid, folded) "
+    "  SELECT n.id, n.folded FROM" CATCH_UP_CHUNK " JOIN notes n ON n.id BETWEEN c.first AND c.upto;"
+    "UPDATE notes_fts_pending SET first = first + " CATCH_UP_ROWS " WHERE rowid ="
+    "  (SELECT rowid FROM notes_fts_pending WHERE last IS NOT NULL ORDER BY first LIMIT 1);"
+    "DELETE FROM notes_fts_pending WHERE first > last;"
+    "COMMIT;";
+
+// closed ranges left to index (an open one belongs to a running bulk insert)
+static bool hasPendingRows(sqlite3* conn) {
+    sqlite3_stmt* stmt = nullptr;
+    bool pending = false;
+    if (sqlite3_prepare_v2(conn, "SELECT 1 FROM notes_fts_pending WHERE last IS NOT NULL LIMIT 1;", -1, &stmt,
+                           nullptr) == SQLITE_OK) {
+        pending = sqlite3_step(stmt) == SQLITE_ROW;
+    }
+    sqlite3_finalize(stmt);
+    return pending;
+}
+
+// sql once, or for the catch-up, chunks until nothing is pending. between
+// chunks a save waiting on the main connection goes first.
+static bool runIndexJob(sqlite3* conn, const char* sql) {
+    do {
+        if (sql == kSqlFtsCatchUp) {
+            while (foregroundWriteWaiting()) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        TRACE_SCOPE(sql == kSqlFtsCatchUp ? "fts catch-up chunk" : "fts rebuild");
+        if (sqlite3_exec(conn, sql, nullptr, nullptr, nullptr) != SQLITE_OK) {
+            sqlite3_exec(conn, "ROLLBACK;", nullptr, nullptr, nullptr);
+            return false;
+        }
+    } while (sql == kSqlFtsCatchUp && hasPendingRows(conn));
+    return true;
+}
+
+static std::string metaValue(const char* key) {
+    std::string v;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT value FROM notes_meta WHERE key = ?;", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, key, -1, SQLITE_STATIC);
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            const unsigned char* t = sqlite3_column_text(stmt, 0);
+            if (t) v = (const char*)t;
+        }
+    }
+    sqlite3_finalize(stmt);
+    return v;
+}
+
+// one background indexer at a time; a catch-up asked for while it runs is
+// done by the same thread before it exits
+static std::mutex g_backfillLock;
+static bool g_backfillRunning = false; // under g_backfillLock
+static bool g_backfillAgain = false;   // under g_backfillLock
+
+static void backfillMain(std::string path, const char* sql) {
+    TRACE_THREAD_NAME("indexer");
+    sqlite3* bdb = nullptr;
+    bool ok = sqlite3_open(path.c_str(), &bdb) == SQLITE_OK;
+    if (ok) {
+        sqlite3_busy_timeout(bdb, 5000);
+        g_backfillDb = bdb;
+    }
+    while (ok) {
+        ok = runIndexJob(bdb, sql);
+        std::lock_guard<std::mutex> lock(g_backfillLock);
+        if (ok && g_backfillAgain) {
+            g_backfillAgain = false;
+            sql = kSqlFtsCatchUp;
+            continue;
+        }
+        // on failure (or close) the rows stay pending for the next open
+        if (ok) g_ftsReady = true;
+        break;
+    }
+    g_backfillDb = nullptr;
+    sqlite3_close(bdb);
+    std::lock_guard<std::mutex> lock(g_backfillLock);
+    g_backfillRunning = false;
+    g_backfillAgain = false;
+}
+
+// run sql (rebuild or catch-up) on the background indexer, searches use LIKE until it is done
+static void startBackfill(const char* sql) {
+    g_ftsReady = false;
+    const char* file = sqlite3_db_filename(db, "main");
+    if (!file || !*file) {
+        // in-memory database, no second connection possible
+        if (runIndexJob(db, sql)) g_ftsReady = true;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(g_backfillLock);
+    if (g_backfillRunning) {
+        g_backfillAgain = true;
+        return;
+    }
+    if (g_backfillThread.joinable()) g_backfillThread.join(); // finished already
+    g_backfillRunning = true;
+    g_backfillThread = std::thread(backfillMain, std::string(file), sql);
+}
+
+bool initSearchIndex(std::string& err) {
+    g_ftsAvailable = false;
+    g_ftsReady = false;
+    char* errmsg = nullptr;
+    if (sqlite3_exec(db, "CREATE TABLE IF NOT EXISTS notes_meta (key TEXT PRIMARY KEY, value TEXT);",
+                     nullptr, nullptr, &errmsg) != SQLITE_OK) {
+        err = errmsg ? errmsg : "";
+        sqlite3_free(errmsg);
+        return false;
+    }
+    bool current = metaValue("fts_version") == FTS_VERSION;
+    // an older notes_trigram has other columns: dropped here, rebuilt below
+    if (!current) sqlite3_exec(db, "DROP TABLE IF EXISTS notes_trigram;", nullptr, nullptr, nullptr);
+    if (sqlite3_exec(db, kSqlFtsSchema, nullptr, nullptr, &errmsg) != SQLITE_OK) {
+        // sqlite built without FTS5: keep working with LIKE only
+        sqlite3_free(errmsg);
+        return true;
+    }
+    g_ftsAvailable = true;
+    if (!current) {
+        // database from before the index (or this version of it) existed: fill it once
+        startBackfill(kSqlFtsRebuild);
+    } else if (hasPendingRows(db)) {
+        // closed before a bulk insert was indexed
+        startBackfill(kSqlFtsCatchUp);
+    } else {
+        g_ftsReady = true;
+    }
+    return true;
+}
+
+bool deferIndexing() {
+    if (!g_ftsAvailable) return false;
+    return sqlite3_exec(db,
+        "INSERT INTO notes_fts_pending (first, last) SELECT ifnull(max(id), 0) + 1, NULL FROM notes;",
+        nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+bool endDeferredIndexing() {
+    return sqlite3_exec(db,
+        "UPDATE notes_fts_pending SET last = (SELECT ifnull(max(id), 0) FROM notes) WHERE last IS NULL;",
+        nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+void startIndexCatchUp() {
+    if (g_ftsAvailable) startBackfill(kSqlFtsCatchUp);
+}
+
+void closeSearchIndex() {
+    {
+        std::lock_guard<std::mutex> lock(g_backfillLock);
+        g_backfillAgain = false;
+    }
+    if (g_backfillThread.joinable()) {
+        sqlite3* bdb = g_backfillDb;
+        if (bdb) sqlite3_interrupt(bdb);
+        g_backfillThread.join();
+    }
+    g_ftsAvailable = false;
+    g_ftsReady = false;
+}
+
+bool searchIndexReady() {
+    return g_ftsReady;
+}
+
+SearchMode effectiveSearchMode() {
+    return g_ftsReady ? (SearchMode)g_searchMode : SearchMode::Like;
+}
+
+void waitForSearchIndex() {
+    if (g_backfillThread.joinable()) g_backfillThread.join();
+}
+
+void setSearchMode(SearchMode mode) {
+    g_searchMode = mode;
+}
+
+SearchMode searchMode() {
+    return g_searchMode;
+}
+
+bool likeWildcards(const std::string& q) {
+    return g_searchMode == SearchMode::Like && q.find_first_of("%_") != std::string::npos;
+}
+
+// ---------------- query building ----------------
+// "a""b" style quoting so user text is never parsed as FTS5 syntax
+static void appendPhrase(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+static size_t utf8Chars(const std::string& s) {
+    size_t n = 0;
+    for (char c : s) n += ((unsigned char)c & 0xC0) != 0x80;
+    return n;
+}
+
+std::string likePattern(const std::string& q) {
+    // q's own % and _ stay wildcards; what folding makes of the rest is literal
+    // (full-width ％ and ＿ fold to % and _)
+    std::string out = "%";
+    size_t i = 0;
+    while (i < q.size()) {
+        size_t end = std::min(q.find_first_of("%_", i), q.size());
+        std::string folded = foldText(q.substr(i, end - i));
+        for (char c : folded) {
+            if (c == '%' || c == '_' || c == '\\') out += '\\';
+            out += c;
+        }
+        if (end < q.size()) out += q[end++];
+        i = end;
+    }
+    out += '%';
+    return out;
+}
+
+// trigram needs at least 3 characters to use the index
+bool trigramSearchable(const std::string& folded) {
+    return utf8Chars(folded) >= 3;
+}
+
+// list queries read the preview column, never the whole content.
+// keyset paging: ?2 = only ids below this, ?3 = row limit (-1 = all)
+static const char* kSqlListAll =
+    "SELECT id, title, ifnull(preview, content), preview IS NULL FROM notes WHERE id < ?2 ORDER BY id DESC LIMIT ?3;";
+// the folded column holds what the scans compare; rows written without it
+// (other programs) are folded on the fly
+#define FOLDED "ifnull(folded, note_fold(title, content))"
+static const char* kSqlLike =
+    "SELECT id, title, ifnull(preview, content), preview IS NULL FROM notes WHERE id < ?2 AND " FOLDED " LIKE ?1 "
+    "ESCAPE '\\' ORDER BY id DESC LIMIT ?3;";
+static const char* kSqlContains =
+    "SELECT id, title, ifnull(preview, content), preview IS NULL FROM notes WHERE id < ?2 "
+    "AND note_contains(" FOLDED ", ?1) ORDER BY id DESC LIMIT ?3;";
+static const char* kSqlTrigram =
+    "SELECT n.id, n.title, ifnull(n.preview, n.content), n.preview IS NULL FROM notes_trigram f JOIN notes n ON n.id = f.rowid "
+    "WHERE notes_trigram MATCH ?1 AND f.rowid < ?2 ORDER BY f.rowid DESC LIMIT ?3;";
+static const char* kSqlWords =
+    "SELECT n.id, n.title, ifnull(n.preview, n.content), n.preview IS NULL FROM notes_fts f JOIN notes n ON n.id = f.rowid "
+    "WHERE notes_fts MATCH ?1 AND f.rowid < ?2 ORDER BY f.rowid DESC LIMIT ?3;";
+// relevance order has no id keyset, ranked results always come in one piece
+static const char* kSqlRanked =
+    "SELECT n.id, n.title, ifnull(n.preview, n.content), n.preview IS NULL FROM notes_fts f JOIN notes n ON n.id = f.rowid "
+    "WHERE notes_fts MATCH ?1 ORDER BY f.rank;";
+
+const char* searchSql(const std::string& q, std::string& arg, bool* keyset) {
+    SearchMode mode = effectiveSearchMode();
+    *keyset = true;
+    if (q.empty()) return kSqlListAll;
+
+    if (mode == SearchMode::Substring) {
+        std::string folded = foldText(q);
+        if (trigramSearchable(folded)) {
+            arg.clear();
+            appendPhrase(arg, folded);
+            return kSqlTrigram;
+        }
+        mode = SearchMode::Like;
+    }
+
+    if (mode == SearchMode::Prefix || mode == SearchMode::Ranked) {
+        arg.clear();
+        size_t i = 0;
+        while (i < q.size()) {
+            while (i < q.size() && (unsigned char)q[i] <= ' ') i++;
+            size_t start = i;
+            while (i < q.size() && (unsigned char)q[i] > ' ') i++;
+            if (i > start) {
+                if (!arg.empty()) arg += ' ';
+                appendPhrase(arg, q.substr(start, i - start));
+                arg += '*';
+            }
+        }
+        if (!arg.empty()) {
+            if (mode == SearchMode::Prefix) return kSqlWords;
+            *keyset = false;
+            return kSqlRanked;
+        }
+    }
+
+    // the folded q in the folded column, by the vectorized note_contains;
+    // LIKE only for wildcards of q's own (before folding) in Like mode. the
+    // other modes land here for short queries and while the index is built,
+    // and take % and _ literally
+    if (!likeWildcards(q)) {
+        arg = foldText(q);
+        return kSqlContains;
+    }
+    arg = likePattern(q);
+    return kSqlLike;
+}
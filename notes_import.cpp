@@ -0,0 +1,369 @@
+// notes_import.cpp
+#include "notes_import.h"
+#include "notes_trace.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// files from this size on are mapped instead of copied into a buffer
+static const unsigned long long kMapBytes = 256 * 1024;
+
+// ---------------- decoding ----------------
+static void appendUtf8(std::string& out, unsigned int cp) {
+    if (cp < 0x80) {
+        out += (char)cp;
+    } else if (cp < 0x800) {
+        out += (char)(0xC0 | (cp >> 6));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += (char)(0xE0 | (cp >> 12));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else {
+        out += (char)(0xF0 | (cp >> 18));
+        out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+static bool validUtf8(const unsigned char* s, size_t n) {
+    size_t i = 0;
+    while (i < n) {
+        unsigned char c = s[i];
+        if (c < 0x80) {
+            i++;
+            continue;
+        }
+        size_t len;
+        unsigned int cp;
+        if (c >= 0xC2 && c <= 0xDF) { len = 2; cp = c & 0x1F; }
+        else if (c >= 0xE0 && c <= 0xEF) { len = 3; cp = c & 0x0F; }
+        else if (c >= 0xF0 && c <= 0xF4) { len = 4; cp = c & 0x07; }
+        else return false;
+        if (i + len > n) return false;
+        for (size_t k = 1; k < len; k++) {
+            if ((s[i + k] & 0xC0) != 0x80) return false;
+            cp = (cp << 6) | (s[i + k] & 0x3F);
+        }
+        // overlong, surrogate or past U+10FFFF
+        if ((len == 3 && cp < 0x800) || (len == 4 && (cp < 0x10000 || cp > 0x10FFFF))) return false;
+        if (cp >= 0xD800 && cp <= 0xDFFF) return false;
+        i += len;
+    }
+    return true;
+}
+
+static void utf16ToUtf8(const unsigned char* s, size_t n, bool bigEndian, std::string& out) {
+    for (size_t i = 0; i + 1 < n; i += 2) {
+        unsigned int u = bigEndian ? (s[i] << 8 | s[i + 1]) : (s[i + 1] << 8 | s[i]);
+        if (u >= 0xD800 && u <= 0xDBFF && i + 3 < n) {
+            unsigned int lo = bigEndian ? (s[i + 2] << 8 | s[i + 3]) : (s[i + 3] << 8 | s[i + 2]);
+            if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                appendUtf8(out, 0x10000 + ((u - 0xD800) << 10) + (lo - 0xDC00));
+                i += 2;
+                continue;
+            }
+        }
+        if (u >= 0xD800 && u <= 0xDFFF) u = 0xFFFD; // unpaired surrogate
+        appendUtf8(out, u);
+    }
+}
+
+// Windows-1252 0x80..0x9F (the rest of the code page is Latin-1)
+static const unsigned short kCp1252High[32] = {
+    0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+    0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178,
+};
+
+std::string decodeNoteText(const char* data, size_t size) {
+    const unsigned char* s = (const unsigned char*)data;
+    std::string utf8;
+    const unsigned char* text = s;
+    size_t n = size;
+    if (n >= 2 && ((s[0] == 0xFF && s[1] == 0xFE) || (s[0] == 0xFE && s[1] == 0xFF))) {
+        utf8.reserve(n);
+        utf16ToUtf8(s + 2, n - 2, s[0] == 0xFE, utf8);
+        text = (const unsigned char*)utf8.data();
+        n = utf8.size();
+    } else {
+        if (n >= 3 && s[0] == 0xEF && s[1] == 0xBB && s[2] == 0xBF) {
+            text += 3;
+            n -= 3;
+        }
+        if (!validUtf8(text, n)) {
+            utf8.reserve(n + n / 8);
+            for (size_t i = 0; i < n; i++) {
+                unsigned char c = text[i];
+                appendUtf8(utf8, c >= 0x80 && c < 0xA0 ? kCp1252High[c - 0x80] : c);
+            }
+            text = (const unsigned char*)utf8.data();
+            n = utf8.size();
+        }
+    }
+
+    // CRLF line ends (the EDIT control shows a lone \n as nothing), no NULs
+    std::string out;
+    out.reserve(n + n / 32);
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = text[i];
+        if (c == '\r') {
+            out += "\r\n";
+            if (i + 1 < n && text[i + 1] == '\n') i++;
+        } else if (c == '\n') {
+            out += "\r\n";
+        } else if (c != 0) {
+            out += (char)c;
+        }
+    }
+    return out;
+}
+
+std::string importTitle(const std::string& path, const std::string& text, ImportTitle mode) {
+    if (mode == ImportTitle::FirstLine) {
+        size_t i = 0;
+        while (i < text.size()) {
+            size_t end = text.find_first_of("\r\n", i);
+            if (end == std::string::npos) end = text.size();
+            size_t b = i, e = end;
+            while (b < e && (text[b] == '#' || text[b] == ' ' || text[b] == '\t')) b++;
+            while (e > b && (text[e - 1] == ' ' || text[e - 1] == '\t')) e--;
+            if (e > b) {
+                // at most 120 bytes, not cutting a UTF-8 sequence
+                if (e - b > 120) {
+                    e = b + 120;
+                    while (e > b && ((unsigned char)text[e] & 0xC0) == 0x80) e--;
+                }
+                return text.substr(b, e - b);
+            }
+            i = end + 1;
+        }
+    }
+    return fs::u8path(path).stem().u8string();
+}
+
+// ---------------- reading ----------------
+// whole file into text (decoded); false if it can't be read or is too big
+static bool readNoteFile(const fs::path& path, unsigned long long maxBytes, std::string& text,
+                         unsigned long long& bytes) {
+#ifdef _WIN32
+    HANDLE f = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (f == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    bool ok = GetFileSizeEx(f, &size) != 0 && (unsigned long long)size.QuadPart <= maxBytes;
+    if (ok) {
+        bytes = (unsigned long long)size.QuadPart;
+        if (bytes == 0) {
+            text.clear();
+        } else if (bytes >= kMapBytes) {
+            HANDLE m = CreateFileMappingW(f, NULL, PAGE_READONLY, 0, 0, NULL);
+            const char* view = m ? (const char*)MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            ok = view != nullptr;
+            if (ok) text = decodeNoteText(view, (size_t)bytes);
+            if (view) UnmapViewOfFile(view);
+            if (m) CloseHandle(m);
+        } else {
+            std::string raw((size_t)bytes, '\0');
+            DWORD got = 0;
+            ok = ReadFile(f, &raw[0], (DWORD)bytes, &got, NULL) != 0 && got == bytes;
+            if (ok) text = decodeNoteText(raw.data(), raw.size());
+        }
+    }
+    CloseHandle(f);
+    return ok;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0 && (unsigned long long)st.st_size <= maxBytes;
+    if (ok) {
+        bytes = (unsigned long long)st.st_size;
+        if (bytes == 0) {
+            text.clear();
+        } else if (bytes >= kMapBytes) {
+            void* view = mmap(nullptr, (size_t)bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            ok = view != MAP_FAILED;
+            if (ok) {
+                madvise(view, (size_t)bytes, MADV_SEQUENTIAL);
+                text = decodeNoteText((const char*)view, (size_t)bytes);
+                munmap(view, (size_t)bytes);
+            }
+        } else {
+            std::string raw((size_t)bytes, '\0');
+            size_t got = 0;
+            while (got < raw.size()) {
+                ssize_t r = read(fd, &raw[got], raw.size() - got);
+                if (r <= 0) break;
+                got += (size_t)r;
+            }
+            ok = got == raw.size();
+            if (ok) text = decodeNoteText(raw.data(), raw.size());
+        }
+    }
+    close(fd);
+    return ok;
+#endif
+}
+
+static bool isNoteFile(const fs::path& p) {
+    std::string ext = p.extension().u8string();
+    for (char& c : ext) c = (char)((c >= 'A' && c <= 'Z') ? c + 32 : c);
+    return ext == ".txt" || ext == ".md";
+}
+
+// ---------------- pipeline ----------------
+// readers fill batches (a run of batchFiles files each) in any order; the writer
+// inserts them in order. readers stay at most a few batches ahead, so memory is
+// bounded by threads * batchFiles files whatever the size of the tree.
+struct ImportBatch {
+    bool ready = false;
+    std::vector<Note> notes;
+    size_t failed = 0;
+    unsigned long long bytes = 0;
+};
+
+bool importDirectory(const std::string& dir, const ImportOptions& options, ImportProgress& result, std::string& err) {
+    TRACE_SCOPE("importDirectory");
+    result = ImportProgress{ 0, 0, 0, 0, 0 };
+    if (!db) {
+        err = "database not open";
+        return false;
+    }
+
+    std::vector<fs::path> files;
+    std::error_code ec;
+    fs::recursive_directory_iterator it(fs::u8path(dir), fs::directory_options::skip_permission_denied, ec);
+    if (ec) {
+        err = dir + ": " + ec.message();
+        return false;
+    }
+    for (fs::recursive_directory_iterator end; it != end; it.increment(ec)) {
+        if (ec) break; // the iterator can't go on past an error
+        std::error_code fileEc; // a file vanishing meanwhile is not an error
+        if (it->is_regular_file(fileEc) && isNoteFile(it->path())) files.push_back(it->path());
+    }
+    // importing part of the tree as if it were all of it would lose notes quietly
+    if (ec) {
+        err = dir + ": " + ec.message();
+        return false;
+    }
+    std::sort(files.begin(), files.end());
+    result.filesTotal = files.size();
+    if (files.empty()) return true;
+
+    size_t perBatch = std::max<size_t>(1, options.batchFiles);
+    size_t batchCount = (files.size() + perBatch - 1) / perBatch;
+    int threads = options.threads > 0 ? options.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    threads = (int)std::min<size_t>((size_t)threads, batchCount);
+    size_t ahead = (size_t)threads * 2; // batches read but not written yet
+
+    std::vector<ImportBatch> batches(batchCount);
+    std::mutex lock;
+    std::condition_variable changed;
+    size_t nextBatch = 0; // under lock
+    size_t written = 0;   // under lock
+    bool abort = false;   // under lock
+
+    auto reader = [&]() {
+        TRACE_THREAD_NAME("import reader");
+        for (;;) {
+            size_t k;
+            {
+                std::unique_lock<std::mutex> l(lock);
+                changed.wait(l, [&] { return abort || nextBatch >= batchCount || nextBatch < written + ahead; });
+                if (abort || nextBatch >= batchCount) return;
+                k = nextBatch++;
+            }
+            TRACE_SCOPE_DETAIL("read batch", nullptr, (long long)k);
+            ImportBatch b;
+            size_t first = k * perBatch, last = std::min(files.size(), first + perBatch);
+            b.notes.reserve(last - first);
+            for (size_t i = first; i < last; i++) {
+                Note n;
+                unsigned long long size = 0;
+                if (!readNoteFile(files[i], options.maxFileBytes, n.content, size)) {
+                    b.failed++;
+                    continue;
+                }
+                n.id = 0;
+                n.title = importTitle(files[i].u8string(), n.content, options.title);
+                b.bytes += size;
+                b.notes.push_back(std::move(n));
+            }
+            b.ready = true;
+            std::lock_guard<std::mutex> l(lock);
+            batches[k] = std::move(b);
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; i++) pool.emplace_back(reader);
+
+    bool ok = beginWrite();
+    if (!ok) err = lastDbError();
+    std::vector<NoteWriteResult> out;
+    for (size_t k = 0; ok && k < batchCount; k++) {
+        ImportBatch b;
+        {
+            std::unique_lock<std::mutex> l(lock);
+            changed.wait(l, [&] { return batches[k].ready; });
+            b = std::move(batches[k]);
+            batches[k] = ImportBatch();
+        }
+        if (!insertNotes(b.notes, out)) {
+            err = lastDbError();
+            ok = false;
+            break;
+        }
+        for (auto& w : out) {
+            if (w.ok) result.imported++;
+            else result.failed++;
+        }
+        result.failed += b.failed;
+        result.bytes += b.bytes;
+        result.filesDone = std::min(files.size(), (k + 1) * perBatch);
+        {
+            std::lock_guard<std::mutex> l(lock);
+            written = k + 1;
+            changed.notify_all();
+        }
+        if (options.progress) options.progress(result, options.user);
+    }
+    {
+        std::lock_guard<std::mutex> l(lock);
+        abort = !ok;
+        changed.notify_all();
+    }
+    for (auto& t : pool) t.join();
+
+    if (ok && !commitWrite()) {
+        err = lastDbError();
+        ok = false;
+    }
+    if (!ok) {
+        rollbackWrite();
+        result.imported = 0;
+    }
+    return ok;
+}
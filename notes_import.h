@@ -0,0 +1,46 @@
+// notes_import.h
+// import a directory tree of .txt / .md files as notes. files are read and
+// decoded on a pool of threads; the calling thread (the one owning db) is the
+// only writer and puts everything in a single transaction.
+#pragma once
+#include "notes_db.h"
+#include <cstddef>
+#include <string>
+
+enum class ImportTitle {
+    FileName,  // file name without extension
+    FirstLine, // first non-empty line ("# " of a markdown heading dropped)
+};
+
+struct ImportProgress {
+    size_t filesTotal;
+    size_t filesDone; // read and handed to the writer
+    size_t imported;
+    size_t failed;    // unreadable, too big
+    unsigned long long bytes;
+};
+
+// called on the writing thread after every batch
+typedef void (*ImportProgressCallback)(const ImportProgress& progress, void* user);
+
+struct ImportOptions {
+    ImportTitle title = ImportTitle::FileName;
+    int threads = 0;                              // readers, 0 = one per core
+    size_t batchFiles = 1000;                     // files per insertNotes call
+    unsigned long long maxFileBytes = 64ull << 20; // bigger files count as failed
+    ImportProgressCallback progress = nullptr;
+    void* user = nullptr;
+};
+
+// walk dir recursively and insert every .txt/.md file (extension case doesn't
+// matter), in path order. text is turned into UTF-8 with CRLF line ends, what
+// the editor window saves: UTF-8 and UTF-16 BOMs are understood, bytes that
+// are not valid UTF-8 are read as Windows-1252.
+// false (and err) if dir can't be listed or the transaction failed; then
+// nothing was imported.
+bool importDirectory(const std::string& dir, const ImportOptions& options, ImportProgress& result, std::string& err);
+
+// the decoding importDirectory applies to one file's bytes
+std::string decodeNoteText(const char* data, size_t size);
+// title for a file (path is only used for its name) per mode
+std::string importTitle(const std::string& path, const std::string& text, ImportTitle mode);
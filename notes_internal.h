@@ -0,0 +1,87 @@
+// notes_internal.h
+// shared between the notes_*.cpp files of the library, not for the app
+#pragma once
+#include "notes_db.h"
+#include "notes_simd.h"
+#include <vector>
+
+// ---------------- connection setup (notes_config.cpp) ----------------
+// apply the current DbProfile to db and start the checkpointer; before any schema
+bool configureConnection(std::string& err);
+// stop the checkpointer (before db is closed)
+void closeConnection();
+// db has been waiting for the write lock in the last few ms
+bool foregroundWriteWaiting();
+
+// ---------------- SQL functions (notes_db.cpp) ----------------
+// the app's own functions (note_preview, note_contains, note_fold); every
+// connection that prepares the app's SQL needs them
+void registerSqlFunctions(sqlite3* conn);
+// the folded column of a note: foldText(title), a newline, foldText(content)
+void foldNote(const std::string& title, const std::string& content, std::string& out);
+
+// ---------------- change tracking (notes_changes.cpp) ----------------
+// the transaction whose rows the update hook saw has committed (COMMIT, or an
+// autocommit write, returned SQLITE_OK): hand its rows to takeNoteChanges
+void noteChangesCommitted();
+
+// ---------------- slow-query log (notes_slowlog.cpp) ----------------
+// hook db up to the slow-query log if it is enabled (file databases only)
+void openSlowQueryLog();
+// unhook and let the writer finish what is queued (before db is closed)
+void closeSlowQueryLog();
+
+// ---------------- resident corpus (notes_resident.cpp) ----------------
+// read every note into memory if enabled (initDatabase, after the schema)
+void loadResidentCorpus();
+void closeResidentCorpus();
+// every successful row write (insert or update) of db. outside a transaction
+// it is applied at once, inside one when commitWrite / rollbackWrite say how it ended
+void residentWritten(int id, const std::string& title, const std::string& content, const std::string& folded);
+void residentCommitted();
+void residentRolledBack();
+// the copy is loaded and up to date with db
+bool residentLoaded();
+// ... and fetchNotePage(q) means plain substring matching in the current mode
+bool residentAnswers(const std::string& q);
+// fetchNotePage / loadNote / contentMatches (no LIKE wildcards in q) from memory;
+// only when the checks above said so. q is matched folded, like the SQL does
+void residentPage(const std::string& q, int beforeId, int limit, NotePage& out);
+bool residentLoad(int id, Note& out);
+void residentContentMatches(const std::vector<int>& ids, const std::string& q, std::vector<int>& out);
+
+// ---------------- SIMD kernels (notes_simd.cpp) ----------------
+// every findNoCase variant this build and CPU can run, by simdLevel name, so
+// they can be checked against each other. each takes 0 < len(p) <= n
+struct FindImpl {
+    const char* name;
+    size_t (*find)(const NoCasePattern& p, const char* hay, size_t n);
+};
+std::vector<FindImpl> findImplementations();
+// foldText without the SSE2 ASCII runs, to check that path against
+void foldTextScalar(const char* text, size_t len, std::string& out);
+
+// ---------------- full-text search (notes_fts.cpp) ----------------
+// create the FTS tables/triggers; starts the one-time backfill if needed
+bool initSearchIndex(std::string& err);
+// stop a running backfill (it resumes on the next open)
+void closeSearchIndex();
+
+// bulk inserts skip the per-row index triggers: inside the write transaction,
+// deferIndexing before the rows and endDeferredIndexing after them mark the new
+// ids pending; after the commit startIndexCatchUp indexes them in the background
+// (searches use LIKE until then). deferIndexing is false without FTS5.
+bool deferIndexing();
+bool endDeferredIndexing();
+void startIndexCatchUp();
+
+// LIKE pattern (ESCAPE '\') matching q anywhere in the folded column: the
+// wildcards typed in q are kept, the text between them is folded and escaped
+std::string likePattern(const std::string& q);
+// a substring search for folded (foldText of the query) can use the trigram
+// index; shorter ones are scanned
+bool trigramSearchable(const std::string& folded);
+// choose the list query for q in the current mode; arg is what to bind to ?1.
+// keyset queries take ?2 (ids below) and ?3 (limit); *keyset is false for
+// ranked search, which can only be read in one piece.
+const char* searchSql(const std::string& q, std::string& arg, bool* keyset);
@@ -0,0 +1,62 @@
+// notes_layout.cpp
+#include "notes_layout.h"
+
+static int rowPitch(const GridLayout& g) {
+    return g.cardH + g.margin;
+}
+
+void layoutForWidth(GridLayout& g, int clientWidth) {
+    int cols = (clientWidth - g.margin) / (g.cardW + g.margin);
+    g.columns = cols < 1 ? 1 : cols;
+}
+
+GridRect cardRect(const GridLayout& g, size_t index) {
+    int col = (int)(index % (size_t)g.columns);
+    int row = (int)(index / (size_t)g.columns);
+    GridRect r;
+    r.left = g.margin + col * (g.cardW + g.margin);
+    r.top = g.margin + row * rowPitch(g);
+    r.right = r.left + g.cardW;
+    r.bottom = r.top + g.cardH;
+    return r;
+}
+
+int contentHeight(const GridLayout& g, size_t count) {
+    size_t rows = (count + (size_t)g.columns - 1) / (size_t)g.columns;
+    return g.margin + (int)rows * rowPitch(g);
+}
+
+void visibleRange(const GridLayout& g, size_t count, int scrollY, int viewH, size_t* first, size_t* last) {
+    int top = scrollY - g.margin;
+    if (top < 0) top = 0;
+    size_t firstRow = (size_t)(top / rowPitch(g));
+    // row r spans [margin + r*pitch, margin + r*pitch + cardH), the last row touching the bottom edge counts
+    int bottom = scrollY + viewH - g.margin;
+    size_t endRow = bottom <= 0 ? 0 : (size_t)((bottom + rowPitch(g) - 1) / rowPitch(g));
+
+    size_t f = firstRow * (size_t)g.columns;
+    size_t l = endRow * (size_t)g.columns;
+    if (l > count) l = count;
+    if (f > l) f = l;
+    *first = f;
+    *last = l;
+}
+
+long cardAt(const GridLayout& g, size_t count, int x, int y) {
+    if (x < g.margin || y < g.margin) return -1;
+    int col = (x - g.margin) / (g.cardW + g.margin);
+    int row = (y - g.margin) / rowPitch(g);
+    if (col >= g.columns) return -1;
+    // inside the card, not in the gap to its right/below
+    if ((x - g.margin) % (g.cardW + g.margin) >= g.cardW) return -1;
+    if ((y - g.margin) % rowPitch(g) >= g.cardH) return -1;
+    size_t index = (size_t)row * (size_t)g.columns + (size_t)col;
+    return index < count ? (long)index : -1;
+}
+
+int clampScroll(const GridLayout& g, size_t count, int scrollY, int viewH) {
+    int maxScroll = contentHeight(g, count) - viewH;
+    if (maxScroll < 0) maxScroll = 0;
+    if (scrollY > maxScroll) return maxScroll;
+    return scrollY < 0 ? 0 : scrollY;
+}
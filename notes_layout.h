@@ -0,0 +1,35 @@
+// notes_layout.h
+// geometry of the card grid, kept free of Win32 so it can be benchmarked
+// headlessly. coordinates are in content space: y = 0 is the top edge of the
+// grid, scrolling only moves the viewport over it.
+#pragma once
+#include <cstddef>
+
+struct GridRect {
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+
+struct GridLayout {
+    int margin = 10;
+    int cardW = 180;
+    int cardH = 110;
+    int columns = 2;
+};
+
+// as many columns as fit in clientWidth (at least one)
+void layoutForWidth(GridLayout& g, int clientWidth);
+
+GridRect cardRect(const GridLayout& g, size_t index);
+int contentHeight(const GridLayout& g, size_t count);
+
+// cards [first, last) that intersect the viewport [scrollY, scrollY + viewH)
+void visibleRange(const GridLayout& g, size_t count, int scrollY, int viewH, size_t* first, size_t* last);
+
+// index of the card under content point (x, y), -1 for the gaps between cards
+long cardAt(const GridLayout& g, size_t count, int x, int y);
+
+// keep scrollY inside [0, contentHeight - viewH]
+int clampScroll(const GridLayout& g, size_t count, int scrollY, int viewH);
@@ -0,0 +1,224 @@
+// notes_metrics.cpp
+#include "notes_metrics.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+
+namespace fs = std::filesystem;
+
+static std::mutex g_metricsLock;
+static DbMetrics g_metrics = {};  // under g_metricsLock
+static std::string g_metricsFile; // under g_metricsLock
+static std::chrono::steady_clock::time_point g_lastSample; // owner thread only
+
+static long long dbStatus(int op) {
+    int cur = 0, high = 0;
+    sqlite3_db_status(db, op, &cur, &high, 0);
+    return cur;
+}
+
+static std::string shortSql(const char* sql) {
+    std::string s;
+    bool space = false;
+    for (const char* p = sql ? sql : ""; *p && s.size() < 160; p++) {
+        if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            space = !s.empty();
+            continue;
+        }
+        if (space) s += ' ';
+        space = false;
+        s += *p;
+    }
+    // cut short: don't end inside a UTF-8 sequence
+    size_t lead = s.size();
+    while (lead > 0 && ((unsigned char)s[lead - 1] & 0xC0) == 0x80) lead--;
+    if (lead > 0) {
+        unsigned char c = (unsigned char)s[lead - 1];
+        size_t len = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+        if (s.size() - (lead - 1) < len) s.resize(lead - 1);
+    }
+    return s;
+}
+
+void sampleDbMetrics() {
+    g_lastSample = std::chrono::steady_clock::now();
+    DbMetrics m = {};
+    m.memoryUsed = sqlite3_memory_used();
+    m.memoryHighwater = sqlite3_memory_highwater(0);
+    if (db) {
+        m.cacheUsed = dbStatus(SQLITE_DBSTATUS_CACHE_USED);
+        m.cacheHits = dbStatus(SQLITE_DBSTATUS_CACHE_HIT);
+        m.cacheMisses = dbStatus(SQLITE_DBSTATUS_CACHE_MISS);
+        m.cacheWrites = dbStatus(SQLITE_DBSTATUS_CACHE_WRITE);
+        m.cacheSpills = dbStatus(SQLITE_DBSTATUS_CACHE_SPILL);
+        m.schemaUsed = dbStatus(SQLITE_DBSTATUS_SCHEMA_USED);
+        m.stmtUsed = dbStatus(SQLITE_DBSTATUS_STMT_USED);
+        m.lookasideUsed = dbStatus(SQLITE_DBSTATUS_LOOKASIDE_USED);
+        // every statement open on the connection, cached or not
+        for (sqlite3_stmt* s = sqlite3_next_stmt(db, nullptr); s; s = sqlite3_next_stmt(db, s)) {
+            StmtMetrics st;
+            st.sql = shortSql(sqlite3_sql(s));
+            st.runs = sqlite3_stmt_status(s, SQLITE_STMTSTATUS_RUN, 0);
+            st.fullscanSteps = sqlite3_stmt_status(s, SQLITE_STMTSTATUS_FULLSCAN_STEP, 0);
+            st.sorts = sqlite3_stmt_status(s, SQLITE_STMTSTATUS_SORT, 0);
+            st.autoindexes = sqlite3_stmt_status(s, SQLITE_STMTSTATUS_AUTOINDEX, 0);
+            st.vmSteps = sqlite3_stmt_status(s, SQLITE_STMTSTATUS_VM_STEP, 0);
+            st.reprepares = sqlite3_stmt_status(s, SQLITE_STMTSTATUS_REPREPARE, 0);
+            st.memUsed = sqlite3_stmt_status(s, SQLITE_STMTSTATUS_MEMUSED, 0);
+            m.fullscanSteps += st.fullscanSteps;
+            m.sorts += st.sorts;
+            m.vmSteps += st.vmSteps;
+            m.statements.push_back(std::move(st));
+        }
+        // the same SQL prepared twice (cached and private) is one series
+        std::sort(m.statements.begin(), m.statements.end(),
+                  [](const StmtMetrics& a, const StmtMetrics& b) { return a.sql < b.sql; });
+        size_t n = 0;
+        for (size_t i = 0; i < m.statements.size(); i++) {
+            StmtMetrics& st = m.statements[i];
+            if (n > 0 && m.statements[n - 1].sql == st.sql) {
+                StmtMetrics& into = m.statements[n - 1];
+                into.runs += st.runs;
+                into.fullscanSteps += st.fullscanSteps;
+                into.sorts += st.sorts;
+                into.autoindexes += st.autoindexes;
+                into.vmSteps += st.vmSteps;
+                into.reprepares += st.reprepares;
+                into.memUsed += st.memUsed;
+            } else {
+                if (n != i) m.statements[n] = std::move(st);
+                n++;
+            }
+        }
+        m.statements.resize(n);
+        std::sort(m.statements.begin(), m.statements.end(), [](const StmtMetrics& a, const StmtMetrics& b) {
+            if (a.fullscanSteps != b.fullscanSteps) return a.fullscanSteps > b.fullscanSteps;
+            return a.vmSteps > b.vmSteps;
+        });
+    }
+
+    std::string file;
+    {
+        std::lock_guard<std::mutex> lock(g_metricsLock);
+        m.samples = g_metrics.samples + 1;
+        file = g_metricsFile;
+        g_metrics = m;
+    }
+    std::string err;
+    if (!file.empty()) writeOpenMetrics(m, file, err);
+}
+
+std::chrono::steady_clock::time_point dbMetricsDue() {
+    return g_lastSample + std::chrono::milliseconds(METRICS_INTERVAL_MS);
+}
+
+void sampleDbMetricsIfDue() {
+    if (std::chrono::steady_clock::now() >= dbMetricsDue()) sampleDbMetrics();
+}
+
+DbMetrics dbMetrics() {
+    std::lock_guard<std::mutex> lock(g_metricsLock);
+    return g_metrics;
+}
+
+void setMetricsFile(const std::string& file) {
+    std::lock_guard<std::mutex> lock(g_metricsLock);
+    g_metricsFile = file;
+}
+
+// ---------------- OpenMetrics ----------------
+static void metric(std::string& out, const char* name, const char* type, const char* help, long long value) {
+    out += "# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += "\n# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += '\n';
+    out += name;
+    if (std::string(type) == "counter") out += "_total";
+    out += ' ' + std::to_string(value) + '\n';
+}
+
+// one family with a sample per statement, labelled by its SQL
+static void stmtMetric(std::string& out, const DbMetrics& m, const char* name, const char* type, const char* help,
+                       long long StmtMetrics::*field) {
+    out += "# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += "\n# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += '\n';
+    bool counter = std::string(type) == "counter";
+    for (auto& st : m.statements) {
+        out += name;
+        out += counter ? "_total{sql=\"" : "{sql=\"";
+        for (char c : st.sql) {
+            if (c == '\\') out += "\\\\";
+            else if (c == '"') out += "\\\"";
+            else out += c;
+        }
+        out += "\"} " + std::to_string(st.*field) + '\n';
+    }
+}
+
+std::string openMetricsText(const DbMetrics& m) {
+    std::string out;
+    metric(out, "notes_sqlite_memory_used_bytes", "gauge", "Heap held by SQLite (sqlite3_memory_used).", m.memoryUsed);
+    metric(out, "notes_sqlite_memory_highwater_bytes", "gauge", "Most heap SQLite has held.", m.memoryHighwater);
+    metric(out, "notes_sqlite_cache_used_bytes", "gauge", "Page cache of the main connection.", m.cacheUsed);
+    metric(out, "notes_sqlite_cache_hits", "counter", "Page cache hits.", m.cacheHits);
+    metric(out, "notes_sqlite_cache_misses", "counter", "Page cache misses (pages read from the file).", m.cacheMisses);
+    metric(out, "notes_sqlite_cache_writes", "counter", "Dirty pages written to the file.", m.cacheWrites);
+    metric(out, "notes_sqlite_cache_spills", "counter", "Dirty pages written before a commit, cache full.", m.cacheSpills);
+    metric(out, "notes_sqlite_schema_used_bytes", "gauge", "Memory of the parsed schema.", m.schemaUsed);
+    metric(out, "notes_sqlite_stmt_used_bytes", "gauge", "Memory of all prepared statements.", m.stmtUsed);
+    metric(out, "notes_sqlite_lookaside_used", "gauge", "Lookaside slots in use.", m.lookasideUsed);
+    metric(out, "notes_sqlite_fullscan_steps", "counter", "Full-scan steps of all open statements.", m.fullscanSteps);
+    stmtMetric(out, m, "notes_sqlite_stmt_runs", "counter", "Runs of the statement.", &StmtMetrics::runs);
+    stmtMetric(out, m, "notes_sqlite_stmt_fullscan_steps", "counter", "Rows stepped through full scans.",
+               &StmtMetrics::fullscanSteps);
+    stmtMetric(out, m, "notes_sqlite_stmt_sorts", "counter", "Sorts done by the statement.", &StmtMetrics::sorts);
+    stmtMetric(out, m, "notes_sqlite_stmt_autoindexes", "counter", "Rows put in automatic indexes.",
+               &StmtMetrics::autoindexes);
+    stmtMetric(out, m, "notes_sqlite_stmt_vm_steps", "counter", "Virtual machine operations.", &StmtMetrics::vmSteps);
+    stmtMetric(out, m, "notes_sqlite_stmt_reprepares", "counter", "Recompiles after schema changes.",
+               &StmtMetrics::reprepares);
+    stmtMetric(out, m, "notes_sqlite_stmt_memory_bytes", "gauge", "Memory held by the statement.", &StmtMetrics::memUsed);
+    out += "# EOF\n";
+    return out;
+}
+
+// written to a temporary name and renamed over file, so a reader never sees half of it
+bool writeOpenMetrics(const DbMetrics& m, const std::string& file, std::string& err) {
+    std::string text = openMetricsText(m);
+    fs::path path = fs::u8path(file);
+    fs::path tmp = path;
+    tmp += ".tmp";
+#ifdef _WIN32
+    FILE* f = _wfopen(tmp.c_str(), L"wb");
+#else
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+#endif
+    if (!f) {
+        err = file + ": cannot create";
+        return false;
+    }
+    bool ok = std::fwrite(text.data(), 1, text.size(), f) == text.size();
+    if (std::fclose(f) != 0) ok = false;
+    std::error_code ec;
+    if (ok) fs::rename(tmp, path, ec);
+    if (!ok || ec) {
+        fs::remove(tmp, ec);
+        err = file + ": write failed";
+        return false;
+    }
+    return true;
+}
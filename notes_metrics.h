@@ -0,0 +1,64 @@
+// notes_metrics.h
+// SQLite's own counters for the main connection: page cache hits/misses and
+// memory (sqlite3_db_status), per statement full-scan steps, sorts, VM steps
+// and reprepares (sqlite3_stmt_status), and the library's heap
+// (sqlite3_memory_used). a query without a usable index shows up as full-scan
+// steps on its statement; the LIKE search walks the id range instead (SQLite
+// counts that as a seek), so there it is VM steps per run that give it away.
+// samples are taken on the thread that owns db (the db worker does it every
+// METRICS_INTERVAL_MS, idle or not); dbMetrics can be read from anywhere.
+#pragma once
+#include "notes_db.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+const int METRICS_INTERVAL_MS = 5000;
+
+// counters of one prepared statement since it was prepared (statements of the
+// cache live as long as the connection; private ones only until finalized)
+struct StmtMetrics {
+    std::string sql;         // whitespace collapsed, cut to 160 bytes
+    long long runs;          // times it was stepped to its first row (or done)
+    long long fullscanSteps; // rows stepped through a table/index scan
+    long long sorts;
+    long long autoindexes;   // rows put in automatic indexes
+    long long vmSteps;
+    long long reprepares;    // recompiles after a schema change
+    long long memUsed;       // bytes held by the statement
+};
+
+struct DbMetrics {
+    long long samples;       // 0: nothing sampled yet
+    long long memoryUsed;    // sqlite3_memory_used, whole process
+    long long memoryHighwater;
+    long long cacheUsed;     // page cache bytes of db
+    long long cacheHits;
+    long long cacheMisses;
+    long long cacheWrites;
+    long long cacheSpills;
+    long long schemaUsed;    // bytes of the parsed schema
+    long long stmtUsed;      // bytes of all prepared statements
+    long long lookasideUsed;
+    // sums over the statements
+    long long fullscanSteps;
+    long long sorts;
+    long long vmSteps;
+    std::vector<StmtMetrics> statements; // most full-scan steps first
+};
+
+// take a sample now (on the thread that owns db)
+void sampleDbMetrics();
+// same, if METRICS_INTERVAL_MS passed since the last one
+void sampleDbMetricsIfDue();
+// when sampleDbMetricsIfDue will take the next one (owner thread)
+std::chrono::steady_clock::time_point dbMetricsDue();
+// the latest sample
+DbMetrics dbMetrics();
+
+// after every sample, also replace file with the sample in OpenMetrics text
+// format (for a node exporter's textfile collector, or just to look at); "" = off
+void setMetricsFile(const std::string& file);
+
+std::string openMetricsText(const DbMetrics& m);
+bool writeOpenMetrics(const DbMetrics& m, const std::string& file, std::string& err);
@@ -0,0 +1,289 @@
+// notes_microbench.cpp
+// latency of the storage/search hot paths as the corpus grows. one database
+// is grown through every size in --sizes (bulk insertNotes), and at each size
+// every operation is timed one call at a time, so p50/p99 are per call.
+//
+//   notes_microbench [--db=microbench.db] [--sizes=1000,10000,100000] [--ops=500]
+//                    [--seed=1] [--profile=balanced] [--resident] [--out=results.json]
+//
+// sizes up to 10000000 work; the build-up dominates the run time there.
+// --resident keeps the notes in memory as well (notes_resident.h), filled
+// through the same writes, so the list and LIKE rows show what it saves.
+#include "notes_corpus.h"
+#include "notes_resident.h"
+#include "notes_search.h"
+#include "notes_simd.h"
+#include "notes_worker.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static double usSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+}
+
+static const char* argValue(int argc, char** argv, const char* name, const char* def) {
+    size_t len = std::strlen(name);
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], name, len) == 0 && argv[i][len] == '=') return argv[i] + len + 1;
+    }
+    return def;
+}
+
+static bool hasFlag(int argc, char** argv, const char* name) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], name) == 0) return true;
+    }
+    return false;
+}
+
+// ---------------- corpus ----------------
+// notes come from the seeded generator (notes_corpus.h): note number i of the
+// corpus is id i+1, and the single writes below take the numbers after the
+// bulk-loaded ones, so every run with the same --seed sees the same text
+static CorpusOptions g_corpus;
+static unsigned long long g_nextNote = 0;
+
+static unsigned int g_seed = 4242;
+static unsigned int nextRand() {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return (g_seed >> 16) & 0x7fff;
+}
+
+static bool growTo(int target, int& size) {
+    CorpusWriteOptions write;
+    CorpusProgress progress;
+    std::string err;
+    if (!writeCorpus((size_t)(target - size), g_corpus, write, progress, err)) return false;
+    size = target;
+    g_nextNote = (unsigned long long)size;
+    return true;
+}
+
+// ---------------- measuring ----------------
+struct Result {
+    int size;
+    std::string name;
+    int ops;
+    double p50, p99, mean, max; // microseconds per call
+};
+
+static std::vector<Result> g_results;
+
+static void record(int size, const char* name, std::vector<double>& us) {
+    Result r;
+    r.size = size;
+    r.name = name;
+    r.ops = (int)us.size();
+    r.p50 = r.p99 = r.mean = r.max = 0;
+    if (!us.empty()) {
+        std::sort(us.begin(), us.end());
+        double sum = 0;
+        for (double v : us) sum += v;
+        r.p50 = us[us.size() / 2];
+        r.p99 = us[std::min(us.size() - 1, us.size() * 99 / 100)];
+        r.mean = sum / us.size();
+        r.max = us.back();
+    }
+    std::printf("%10d  %-22s %7d ops  p50 %10.1f us  p99 %10.1f us  mean %10.1f us\n",
+        size, name, r.ops, r.p50, r.p99, r.mean);
+    std::fflush(stdout);
+    g_results.push_back(r);
+}
+
+// time fn() ops times, one sample per call
+template <class Fn>
+static void measure(int size, const char* name, int ops, Fn fn) {
+    std::vector<double> us;
+    us.reserve(ops);
+    for (int i = 0; i < ops; i++) {
+        Clock::time_point t0 = Clock::now();
+        fn(i);
+        us.push_back(usSince(t0));
+    }
+    record(size, name, us);
+}
+
+// numbers from differently built binaries don't compare (cmake passes $<CONFIG>)
+#ifndef NOTES_BUILD_TYPE
+#define NOTES_BUILD_TYPE ""
+#endif
+
+static bool writeJson(const char* file, const char* profile, bool resident) {
+    FILE* f = std::fopen(file, "wb");
+    if (!f) return false;
+    std::fprintf(f, "{\"bench\":\"notes_microbench\",\"build\":\"%s\",\"sqlite\":\"%s\",\"profile\":\"%s\","
+        "\"seed\":%llu,\"resident\":%s,\"results\":[", NOTES_BUILD_TYPE, sqlite3_libversion(), profile,
+        g_corpus.seed, resident ? "true" : "false");
+    for (size_t i = 0; i < g_results.size(); i++) {
+        const Result& r = g_results[i];
+        std::fprintf(f, "%s\n{\"size\":%d,\"name\":\"%s\",\"ops\":%d,\"p50_us\":%.2f,\"p99_us\":%.2f,"
+            "\"mean_us\":%.2f,\"max_us\":%.2f,\"ops_per_sec\":%.1f}",
+            i ? "," : "", r.size, r.name.c_str(), r.ops, r.p50, r.p99, r.mean, r.max,
+            r.mean > 0 ? 1e6 / r.mean : 0.0);
+    }
+    std::fprintf(f, "\n]}\n");
+    return std::fclose(f) == 0;
+}
+
+// ---------------- large bodies ----------------
+// LIKE against note_contains (the scan search falls back to) on note bodies
+// far bigger than the generated ones: a temp table of BIG_NOTES bodies of
+// BIG_BYTES each, pasted together from generated notes, and patterns that
+// match nothing, so every byte is looked at. LIKE jumps from one occurrence of
+// the first pattern byte to the next, which is quick for "zzzzzz"; the near
+// miss starts like the text does
+static const int BIG_NOTES = 32;
+static const size_t BIG_BYTES = 256 * 1024;
+
+static bool fillBigNotes() {
+    if (sqlite3_exec(db, "CREATE TEMP TABLE big_notes(content TEXT);", nullptr, nullptr, nullptr) != SQLITE_OK) return false;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "INSERT INTO big_notes(content) VALUES(?1);", -1, &stmt, nullptr) != SQLITE_OK) return false;
+    unsigned long long number = 0;
+    Note n;
+    bool ok = true;
+    for (int i = 0; i < BIG_NOTES && ok; i++) {
+        std::string body;
+        while (body.size() < BIG_BYTES) {
+            corpusNote(g_corpus, number++, n);
+            body += n.content;
+            body += "\n\n";
+        }
+        sqlite3_bind_text(stmt, 1, body.data(), (int)body.size(), SQLITE_TRANSIENT);
+        ok = sqlite3_step(stmt) == SQLITE_DONE;
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+    return ok;
+}
+
+static void measureBigScan(int size, const char* name, int ops, const char* sql, const char* arg) {
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return;
+    sqlite3_bind_text(stmt, 1, arg, -1, SQLITE_STATIC);
+    measure(size, name, ops, [&](int) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {}
+        sqlite3_reset(stmt);
+    });
+    sqlite3_finalize(stmt);
+}
+
+// ---------------- main ----------------
+int main(int argc, char** argv) {
+    std::string path = argValue(argc, argv, "--db", "microbench.db");
+    int ops = std::atoi(argValue(argc, argv, "--ops", "500"));
+    const char* out = argValue(argc, argv, "--out", nullptr);
+    const char* profileArg = argValue(argc, argv, "--profile", "balanced");
+    DbProfile profile;
+    if (!profileFromName(profileArg, profile)) {
+        std::fprintf(stderr, "unknown profile (durable, balanced, throughput)\n");
+        return 1;
+    }
+    std::vector<int> sizes;
+    for (const char* s = argValue(argc, argv, "--sizes", "1000,10000,100000"); *s;) {
+        sizes.push_back(std::atoi(s));
+        const char* comma = std::strchr(s, ',');
+        if (!comma) break;
+        s = comma + 1;
+    }
+    std::sort(sizes.begin(), sizes.end());
+    g_corpus.seed = std::strtoull(argValue(argc, argv, "--seed", "1"), nullptr, 10);
+    bool resident = hasFlag(argc, argv, "--resident");
+    if (resident) enableResidentCorpus(ResidentOptions());
+
+    for (const char* suffix : { "", "-wal", "-shm" }) std::remove((path + suffix).c_str());
+    setDbProfile(profile);
+    if (!initDatabase(path.c_str())) {
+        std::fprintf(stderr, "initDatabase failed: %s\n", lastDbError().c_str());
+        return 1;
+    }
+
+    int size = 0;
+    for (int target : sizes) {
+        if (target <= 0) continue;
+        Clock::time_point t0 = Clock::now();
+        int before = size;
+        if (!growTo(target, size)) {
+            std::fprintf(stderr, "insert failed: %s\n", lastDbError().c_str());
+            return 1;
+        }
+        waitForSearchIndex();
+        double us = usSince(t0);
+        std::vector<double> load;
+        if (size > before) load.push_back(us / (size - before)); // per row, index included
+        record(size, "bulk_insert_row", load);
+
+        // single writes, what an editor save costs (autocommit each); the text
+        // is generated before the clock starts
+        std::vector<Note> fresh(ops);
+        for (auto& note : fresh) corpusNote(g_corpus, g_nextNote++, note);
+        measure(size, "insert", ops, [&](int i) { insertNotePrepared(fresh[i].title, fresh[i].content); });
+        size += ops;
+        for (auto& note : fresh) corpusNote(g_corpus, g_nextNote++, note);
+        measure(size, "update", ops, [&](int i) {
+            int id = 1 + (int)((nextRand() * 32768u + nextRand()) % (unsigned)size);
+            updateNotePrepared(id, fresh[i].title, fresh[i].content);
+        });
+        // the folded text every save computes (foldText of content)
+        std::string folded;
+        measure(size, "fold_content", ops, [&](int i) {
+            folded.clear();
+            foldText(fresh[i].content.data(), fresh[i].content.size(), folded);
+        });
+        // opening a note in the editor
+        Note n;
+        measure(size, "load", ops, [&](int) {
+            loadNote(1 + (int)((nextRand() * 32768u + nextRand()) % (unsigned)size), n);
+        });
+        // the list: first screen, and a page from the middle (keyset seek)
+        NotePage page;
+        measure(size, "list_first_page", ops, [&](int) { fetchNotePage("", 0, FIRST_PAGE_ROWS, page); });
+        measure(size, "list_mid_page", ops, [&](int) { fetchNotePage("", size / 2, PAGE_ROWS, page); });
+        // search: first page of a short (LIKE fallback) and a long (trigram) pattern,
+        // a word prefix, and a pattern that matches nothing (whole index walked, and
+        // in LIKE mode every row scanned)
+        static const struct { SearchMode mode; const char* name; const char* q; } kSearches[] = {
+            { SearchMode::Substring, "search_short", "ra" },
+            { SearchMode::Substring, "search_long", "rapat kerja" },
+            { SearchMode::Prefix, "search_prefix", "kan" },
+            { SearchMode::Substring, "search_miss", "zzzzzz" },
+            { SearchMode::Like, "search_like_miss", "zzzzzz" },
+        };
+        for (auto& s : kSearches) {
+            setSearchMode(s.mode);
+            measure(size, s.name, ops, [&](int) { fetchNotePage(s.q, 0, FIRST_PAGE_ROWS, page); });
+        }
+        setSearchMode(SearchMode::Substring);
+    }
+    if (size > 0) {
+        if (!fillBigNotes()) {
+            std::fprintf(stderr, "big notes failed: %s\n", sqlite3_errmsg(db));
+            return 1;
+        }
+        int scans = std::max(5, ops / 10);
+        static const struct { const char* like; const char* contains; const char* q; } kBigScans[] = {
+            { "big_like_miss", "big_contains_miss", "zzzzzz" },
+            { "big_like_near_miss", "big_contains_near_miss", "anggaran zz" },
+        };
+        for (auto& b : kBigScans) {
+            std::string pattern = std::string("%") + b.q + "%";
+            measureBigScan(size, b.like, scans, "SELECT count(*) FROM big_notes WHERE content LIKE ?1;", pattern.c_str());
+            measureBigScan(size, b.contains, scans,
+                "SELECT count(*) FROM big_notes WHERE note_contains(content, ?1);", b.q);
+        }
+    }
+    closeDatabase();
+
+    if (out && !writeJson(out, profileArg, resident)) {
+        std::fprintf(stderr, "cannot write %s\n", out);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,291 @@
+// notes_resident.cpp
+#include "notes_resident.h"
+#include "notes_internal.h"
+#include "notes_search.h"
+#include "notes_simd.h"
+#include "notes_trace.h"
+#include <algorithm>
+#include <chrono>
+
+static ResidentOptions g_options;
+static bool g_enabled = false;
+
+// one slot per note, ids ascending. a slot's title is titles[titleAt, titleAt + titleLen),
+// its content and folded text (what searches compare) likewise; text an update
+// outgrew stays behind as garbage
+struct ResidentCorpus {
+    std::vector<int> ids;
+    std::vector<size_t> titleAt;
+    std::vector<unsigned> titleLen;
+    std::vector<size_t> contentAt;
+    std::vector<unsigned> contentLen;
+    std::vector<size_t> foldedAt;
+    std::vector<unsigned> foldedLen;
+    std::vector<char> titles;
+    std::vector<char> contents;
+    std::vector<char> folded;
+    size_t garbage = 0;
+};
+
+static ResidentCorpus g_corpus;
+
+static size_t residentBytes() {
+    return g_corpus.titles.size() + g_corpus.contents.size() + g_corpus.folded.size();
+}
+static bool g_loaded = false;
+static double g_loadMs = 0;
+static long long g_pages = 0;
+static long long g_loads = 0;
+
+// rows written by the open transaction, applied when it commits
+struct ResidentWrite {
+    int id;
+    std::string title;
+    std::string content;
+    std::string folded;
+};
+static std::vector<ResidentWrite> g_uncommitted;
+
+void enableResidentCorpus(const ResidentOptions& options) {
+    g_options = options;
+    g_enabled = true;
+}
+
+void disableResidentCorpus() {
+    g_enabled = false;
+}
+
+ResidentStats residentStats() {
+    ResidentStats s;
+    s.loaded = g_loaded;
+    s.notes = g_corpus.ids.size();
+    s.bytes = residentBytes();
+    s.garbageBytes = g_corpus.garbage;
+    s.loadMs = g_loadMs;
+    s.pages = g_pages;
+    s.loads = g_loads;
+    return s;
+}
+
+static void dropResident() {
+    g_corpus = ResidentCorpus(); // gives the memory back
+    g_uncommitted.clear();
+    g_loaded = false;
+}
+
+
+// ---------------- load ----------------
+void loadResidentCorpus() {
+    dropResident();
+    if (!g_enabled || !db) return;
+    TRACE_SCOPE("loadResidentCorpus");
+    auto t0 = std::chrono::steady_clock::now();
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT id, title, content, ifnull(folded, note_fold(title, content)) FROM notes ORDER BY id;",
+                           -1, &stmt, nullptr) != SQLITE_OK) {
+        sqlite3_finalize(stmt);
+        return;
+    }
+    ResidentCorpus& c = g_corpus;
+    int rc;
+    bool fits = true;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        const char* title = (const char*)sqlite3_column_text(stmt, 1);
+        size_t titleLen = (size_t)sqlite3_column_bytes(stmt, 1);
+        const char* content = (const char*)sqlite3_column_text(stmt, 2);
+        size_t contentLen = (size_t)sqlite3_column_bytes(stmt, 2);
+        const char* folded = (const char*)sqlite3_column_text(stmt, 3);
+        size_t foldedLen = (size_t)sqlite3_column_bytes(stmt, 3);
+        if (residentBytes() + titleLen + contentLen + foldedLen > g_options.maxBytes) {
+            fits = false;
+            break;
+        }
+        c.ids.push_back(sqlite3_column_int(stmt, 0));
+        c.titleAt.push_back(c.titles.size());
+        c.titleLen.push_back((unsigned)titleLen);
+        if (titleLen) c.titles.insert(c.titles.end(), title, title + titleLen);
+        c.contentAt.push_back(c.contents.size());
+        c.contentLen.push_back((unsigned)contentLen);
+        if (contentLen) c.contents.insert(c.contents.end(), content, content + contentLen);
+        c.foldedAt.push_back(c.folded.size());
+        c.foldedLen.push_back((unsigned)foldedLen);
+        if (foldedLen) c.folded.insert(c.folded.end(), folded, folded + foldedLen);
+    }
+    sqlite3_finalize(stmt);
+    if (!fits || rc != SQLITE_DONE) {
+        dropResident();
+        return;
+    }
+    g_loaded = true;
+    g_loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void closeResidentCorpus() {
+    dropResident();
+}
+
+// ---------------- writes ----------------
+// copy the live text of every slot into fresh buffers, in slot order
+static void compact() {
+    ResidentCorpus& c = g_corpus;
+    size_t titleBytes = 0, contentBytes = 0, foldedBytes = 0;
+    for (size_t i = 0; i < c.ids.size(); i++) {
+        titleBytes += c.titleLen[i];
+        contentBytes += c.contentLen[i];
+        foldedBytes += c.foldedLen[i];
+    }
+    std::vector<char> titles, contents, folded;
+    titles.reserve(titleBytes);
+    contents.reserve(contentBytes);
+    folded.reserve(foldedBytes);
+    for (size_t i = 0; i < c.ids.size(); i++) {
+        const char* t = c.titles.data() + c.titleAt[i];
+        c.titleAt[i] = titles.size();
+        titles.insert(titles.end(), t, t + c.titleLen[i]);
+        const char* b = c.contents.data() + c.contentAt[i];
+        c.contentAt[i] = contents.size();
+        contents.insert(contents.end(), b, b + c.contentLen[i]);
+        const char* f = c.folded.data() + c.foldedAt[i];
+        c.foldedAt[i] = folded.size();
+        folded.insert(folded.end(), f, f + c.foldedLen[i]);
+    }
+    c.titles.swap(titles);
+    c.contents.swap(contents);
+    c.folded.swap(folded);
+    c.garbage = 0;
+}
+
+// slot text: written over in place if it still fits, else appended
+static void putText(std::vector<char>& buf, size_t& at, unsigned& len, const std::string& text) {
+    if (text.size() <= len) {
+        std::copy(text.begin(), text.end(), buf.begin() + (std::ptrdiff_t)at);
+        g_corpus.garbage += len - text.size();
+    } else {
+        g_corpus.garbage += len;
+        at = buf.size();
+        buf.insert(buf.end(), text.begin(), text.end());
+    }
+    len = (unsigned)text.size();
+}
+
+static void applyWrite(int id, const std::string& title, const std::string& content, const std::string& folded) {
+    ResidentCorpus& c = g_corpus;
+    auto it = std::lower_bound(c.ids.begin(), c.ids.end(), id);
+    size_t slot = (size_t)(it - c.ids.begin());
+    if (it == c.ids.end() || *it != id) {
+        // new ids come from AUTOINCREMENT, so this is nearly always the end
+        c.ids.insert(it, id);
+        c.titleAt.insert(c.titleAt.begin() + (std::ptrdiff_t)slot, 0);
+        c.titleLen.insert(c.titleLen.begin() + (std::ptrdiff_t)slot, 0);
+        c.contentAt.insert(c.contentAt.begin() + (std::ptrdiff_t)slot, 0);
+        c.contentLen.insert(c.contentLen.begin() + (std::ptrdiff_t)slot, 0);
+        c.foldedAt.insert(c.foldedAt.begin() + (std::ptrdiff_t)slot, 0);
+        c.foldedLen.insert(c.foldedLen.begin() + (std::ptrdiff_t)slot, 0);
+    }
+    putText(c.titles, c.titleAt[slot], c.titleLen[slot], title);
+    putText(c.contents, c.contentAt[slot], c.contentLen[slot], content);
+    putText(c.folded, c.foldedAt[slot], c.foldedLen[slot], folded);
+
+    if (c.garbage > ((size_t)1 << 20) && c.garbage > residentBytes() / 2) compact();
+    if (residentBytes() > g_options.maxBytes) {
+        compact();
+        if (residentBytes() > g_options.maxBytes) dropResident();
+    }
+}
+
+void residentWritten(int id, const std::string& title, const std::string& content, const std::string& folded) {
+    if (!g_loaded) return;
+    // outside a transaction the statement has committed already
+    if (sqlite3_get_autocommit(db)) applyWrite(id, title, content, folded);
+    else g_uncommitted.push_back(ResidentWrite{ id, title, content, folded });
+}
+
+void residentCommitted() {
+    std::vector<ResidentWrite> writes;
+    writes.swap(g_uncommitted);
+    for (auto& w : writes) {
+        if (!g_loaded) break; // dropped, over maxBytes
+        applyWrite(w.id, w.title, w.content, w.folded);
+    }
+}
+
+void residentRolledBack() {
+    g_uncommitted.clear();
+}
+
+// ---------------- reads ----------------
+// the copy has every committed row, and db sees no uncommitted ones of its own
+static bool residentCurrent() {
+    if (!g_loaded) return false;
+    if (g_uncommitted.empty()) return true;
+    // a transaction ended without commitWrite/rollbackWrite: which way is unknown
+    if (sqlite3_get_autocommit(db)) dropResident();
+    return false;
+}
+
+bool residentLoaded() {
+    return residentCurrent();
+}
+
+bool residentAnswers(const std::string& q) {
+    SearchMode mode = effectiveSearchMode();
+    // a trigram lookup beats scanning everything, most of all for rare words;
+    // the same test searchSql uses to pick it
+    if (mode == SearchMode::Substring && trigramSearchable(foldText(q))) return false;
+    return residentCurrent() && matchableInMemory(q, mode);
+}
+
+// p is folded too, so this is the search the SQL does on the folded column
+static inline bool slotMatches(size_t i, const NoCasePattern& p) {
+    const ResidentCorpus& c = g_corpus;
+    return containsNoCase(p, c.folded.data() + c.foldedAt[i], c.foldedLen[i]);
+}
+
+void residentPage(const std::string& q, int beforeId, int limit, NotePage& out) {
+    TRACE_SCOPE_DETAIL("residentPage", q.empty() ? nullptr : "query", beforeId);
+    const ResidentCorpus& c = g_corpus;
+    g_pages++;
+    out.notes.clear();
+    out.nextBefore = beforeId;
+    out.more = false;
+    NoCasePattern p;
+    compileNoCase(foldText(q), p);
+    size_t end = beforeId > 0 ? (size_t)(std::lower_bound(c.ids.begin(), c.ids.end(), beforeId) - c.ids.begin())
+                              : c.ids.size();
+    for (size_t i = end; i-- > 0;) {
+        if (!q.empty() && !slotMatches(i, p)) continue;
+        Note n;
+        n.id = c.ids[i];
+        n.title.assign(c.titles.data() + c.titleAt[i], c.titleLen[i]);
+        n.content = makePreview(c.contents.data() + c.contentAt[i], c.contentLen[i]);
+        out.notes.push_back(std::move(n));
+        if (limit > 0 && (int)out.notes.size() == limit) break;
+    }
+    if (!out.notes.empty()) out.nextBefore = out.notes.back().id;
+    out.more = limit > 0 && (int)out.notes.size() == limit;
+}
+
+bool residentLoad(int id, Note& out) {
+    const ResidentCorpus& c = g_corpus;
+    g_loads++;
+    auto it = std::lower_bound(c.ids.begin(), c.ids.end(), id);
+    if (it == c.ids.end() || *it != id) return false;
+    size_t i = (size_t)(it - c.ids.begin());
+    out.id = id;
+    out.title.assign(c.titles.data() + c.titleAt[i], c.titleLen[i]);
+    out.content.assign(c.contents.data() + c.contentAt[i], c.contentLen[i]);
+    return true;
+}
+
+void residentContentMatches(const std::vector<int>& ids, const std::string& q, std::vector<int>& out) {
+    const ResidentCorpus& c = g_corpus;
+    NoCasePattern p;
+    compileNoCase(foldText(q), p);
+    out.clear();
+    for (int id : ids) {
+        auto it = std::lower_bound(c.ids.begin(), c.ids.end(), id);
+        if (it == c.ids.end() || *it != id) continue;
+        size_t i = (size_t)(it - c.ids.begin());
+        if (slotMatches(i, p)) out.push_back(id);
+    }
+}
@@ -0,0 +1,38 @@
+// notes_resident.h
+// optional resident copy of every note, so a search-as-you-type keystroke is
+// a scan of memory instead of a walk through SQLite pages. titles, contents
+// and the folded text searches compare sit in three contiguous buffers with
+// per-note offset tables (one slot per note, in id order), not in Note strings;
+// only the rows of the page asked for become Notes. the queries SQLite would
+// answer by scanning every row (the list, LIKE search without wildcards) are
+// answered here with findNoCase (notes_simd.h), as are loadNote and the
+// content checks of SearchSession; the index-backed ones (trigram, word and
+// ranked search) still go to SQLite, which finds a rare word faster than any scan.
+//
+// every write of this library updates the copy as it commits, so it never
+// lags behind db. other processes writing the same file are not seen: the
+// copy is as of when the database was opened, plus this process's writes.
+#pragma once
+#include <cstddef>
+
+struct ResidentOptions {
+    size_t maxBytes = (size_t)1 << 30; // text held; past it the copy is dropped and SQLite answers again
+};
+
+// takes effect when the database is next opened; loading reads every note
+// once (on the thread opening it), so enable it before initDatabase /
+// startDbWorker
+void enableResidentCorpus(const ResidentOptions& options);
+void disableResidentCorpus();
+
+// on the thread that owns db
+struct ResidentStats {
+    bool loaded;
+    size_t notes;
+    size_t bytes;        // titles + contents + folded text, garbage included
+    size_t garbageBytes; // left behind by updates, until the next compaction
+    double loadMs;
+    long long pages;     // fetchNotePage calls answered from memory
+    long long loads;     // loadNote calls answered from memory
+};
+ResidentStats residentStats();
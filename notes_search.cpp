@@ -0,0 +1,138 @@
+// notes_search.cpp
+#include "notes_search.h"
+#include "notes_simd.h"
+#include "notes_trace.h"
+#include <algorithm>
+#include <unordered_set>
+
+static inline unsigned char foldAscii(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + 32) : c;
+}
+
+bool containsNoCase(const std::string& haystack, const std::string& needle) {
+    if (needle.empty()) return true;
+    auto it = std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(),
+        [](char a, char b) { return foldAscii((unsigned char)a) == foldAscii((unsigned char)b); });
+    return it != haystack.end();
+}
+
+bool containsFolded(const std::string& haystack, const std::string& needle) {
+    NoCasePattern p;
+    compileNoCase(foldText(needle), p);
+    std::string folded;
+    foldText(haystack.data(), haystack.size(), folded);
+    return containsNoCase(p, folded.data(), folded.size());
+}
+
+bool matchableInMemory(const std::string& q, SearchMode mode) {
+    if (q.empty()) return true;
+    // % and _ are plain characters except in Like
+    if (mode == SearchMode::Like && likeWildcards(q)) return false;
+    // both compare the folded text (the trigram index is built from it)
+    return mode == SearchMode::Like || mode == SearchMode::Substring;
+}
+
+// p in the folded text[0, len)
+static bool foldedMatches(const char* text, size_t len, const NoCasePattern& p, std::string& buf) {
+    buf.clear();
+    foldText(text, len, buf);
+    return containsNoCase(p, buf.data(), buf.size());
+}
+
+bool noteMatchesQuery(const Note& n, const std::string& q) {
+    NoCasePattern p;
+    compileNoCase(foldText(q), p);
+    std::string buf;
+    return foldedMatches(n.title.data(), n.title.size(), p, buf) ||
+           foldedMatches(n.content.data(), n.content.size(), p, buf);
+}
+
+// like noteMatchesQuery for a list row, ignoring the "..." makePreview appended
+static bool previewMatches(const Note& n, const NoCasePattern& p, std::string& buf) {
+    if (foldedMatches(n.title.data(), n.title.size(), p, buf)) return true;
+    size_t len = previewIsPartial(n.content) ? n.content.size() - 3 : n.content.size();
+    return foldedMatches(n.content.data(), len, p, buf);
+}
+
+// the new matches are a subset of the old ones only when q contains the
+// previous query (e.g. "cat" -> "cata") and both are plain substring searches
+bool SearchSession::canRefine(const std::string& q) const {
+    if (!valid_ || mode_ != effectiveSearchMode()) return false;
+    if (q.size() <= lastQuery_.size() || !matchableInMemory(q, mode_)) return false;
+    return containsFolded(q, lastQuery_);
+}
+
+bool SearchSession::search(const std::string& q, int limit, NotePage& out) {
+    TRACE_SCOPE_DETAIL("SearchSession::search", canRefine(q) ? "refine" : nullptr, (long long)q.size());
+    // read before the query runs: the index may come ready meanwhile
+    SearchMode mode = effectiveSearchMode();
+    if (canRefine(q)) {
+        // rows only hold previews: a match there is certain, a miss in a cut
+        // preview has to be checked against the full content in SQLite
+        std::vector<char> keep(last_.notes.size(), 0);
+        std::vector<int> unsure;
+        NoCasePattern p;
+        compileNoCase(foldText(q), p);
+        std::string buf;
+        for (size_t i = 0; i < last_.notes.size(); i++) {
+            const Note& n = last_.notes[i];
+            if (previewMatches(n, p, buf)) keep[i] = 1;
+            else if (previewIsPartial(n.content)) unsure.push_back(n.id);
+        }
+        if (!unsure.empty()) {
+            std::vector<int> hits;
+            if (!contentMatches(unsure, q, hits)) {
+                valid_ = false;
+                return false;
+            }
+            std::unordered_set<int> hitSet(hits.begin(), hits.end());
+            for (size_t i = 0; i < last_.notes.size(); i++) {
+                if (hitSet.count(last_.notes[i].id)) keep[i] = 1;
+            }
+        }
+        out.notes.clear();
+        for (size_t i = 0; i < last_.notes.size(); i++) {
+            if (keep[i]) out.notes.push_back(last_.notes[i]);
+        }
+        out.nextBefore = last_.nextBefore;
+        out.more = last_.more;
+        stats_.memoryRefines++;
+
+        // the filtered rows may not fill a page: top it up from below the covered range
+        if (limit > 0 && out.more && (int)out.notes.size() < limit) {
+            NotePage rest;
+            stats_.sqlQueries++;
+            if (!fetchNotePage(q, out.nextBefore, limit - (int)out.notes.size(), rest)) {
+                valid_ = false;
+                return false;
+            }
+            for (auto& n : rest.notes) out.notes.push_back(std::move(n));
+            out.nextBefore = rest.nextBefore;
+            out.more = rest.more;
+        }
+    } else {
+        stats_.sqlQueries++;
+        if (!fetchNotePage(q, 0, limit, out)) {
+            valid_ = false;
+            return false;
+        }
+    }
+    valid_ = true;
+    mode_ = mode;
+    lastQuery_ = q;
+    last_ = out;
+    return true;
+}
+
+void SearchSession::extend(const std::string& q, int beforeId, const NotePage& page) {
+    if (!valid_ || q != lastQuery_ || !last_.more || beforeId != last_.nextBefore) return;
+    last_.notes.insert(last_.notes.end(), page.notes.begin(), page.notes.end());
+    last_.nextBefore = page.nextBefore;
+    last_.more = page.more;
+}
+
+void SearchSession::invalidate() {
+    valid_ = false;
+    last_.notes.clear();
+    lastQuery_.clear();
+}
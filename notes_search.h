@@ -0,0 +1,45 @@
+// notes_search.h
+// search-as-you-type session: typing one more character only narrows the
+// previous answer, so it is filtered in memory instead of asking SQLite again.
+// with paged answers the filtered rows are exact for ids >= nextBefore, so
+// only the rest of the page has to come from SQLite.
+#pragma once
+#include "notes_db.h"
+#include <string>
+#include <vector>
+
+struct SearchSessionStats {
+    long long sqlQueries;    // pages read from SQLite
+    long long memoryRefines; // answered by filtering the previous result
+};
+
+class SearchSession {
+public:
+    // the first rows of fetchNotes(q), like fetchNotePage(q, 0, limit); false if
+    // the query was interrupted. a refined answer may hold more than limit rows.
+    bool search(const std::string& q, int limit, NotePage& out);
+    // a following page (fetched from beforeId) of the last query: remembered so
+    // the next refinement covers it too
+    void extend(const std::string& q, int beforeId, const NotePage& page);
+    // call after any write, the remembered rows may be out of date
+    void invalidate();
+    SearchSessionStats stats() const { return stats_; }
+
+private:
+    bool canRefine(const std::string& q) const;
+
+    bool valid_ = false;
+    SearchMode mode_ = SearchMode::Like;
+    std::string lastQuery_;
+    NotePage last_;
+    SearchSessionStats stats_ = { 0, 0 };
+};
+
+// ASCII case-insensitive substring test, the same folding LIKE does
+bool containsNoCase(const std::string& haystack, const std::string& needle);
+// substring test the way searches compare: both folded (foldText, notes_simd.h)
+bool containsFolded(const std::string& haystack, const std::string& needle);
+
+// true when noteMatchesQuery picks exactly the rows fetchNotes(q) would in mode
+bool matchableInMemory(const std::string& q, SearchMode mode);
+bool noteMatchesQuery(const Note& n, const std::string& q);
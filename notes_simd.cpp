@@ -0,0 +1,252 @@
+// notes_simd.cpp
+#include "notes_simd.h"
+#include "notes_fold_table.h"
+#include "notes_internal.h"
+#include <algorithm>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NOTES_SSE2 1
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+#if NOTES_SSE2 && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NOTES_AVX2 1
+#include <immintrin.h>
+#endif
+
+static inline unsigned char foldByte(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + 32) : c;
+}
+
+void compileNoCase(const char* needle, size_t len, NoCasePattern& out) {
+    out.folded.resize(len);
+    for (size_t i = 0; i < len; i++) out.folded[i] = (char)foldByte((unsigned char)needle[i]);
+}
+
+// hay[0, k) against the folded needle
+static inline bool equalNoCase(const char* hay, const char* folded, size_t k) {
+    for (size_t i = 0; i < k; i++) {
+        if (foldByte((unsigned char)hay[i]) != (unsigned char)folded[i]) return false;
+    }
+    return true;
+}
+
+// candidates from `from` on, one at a time (short haystacks and the tails of the vector loops)
+static size_t findScalar(const NoCasePattern& p, const char* hay, size_t n, size_t from) {
+    size_t k = p.folded.size();
+    const char* f = p.folded.data();
+    unsigned char first = (unsigned char)f[0];
+    for (size_t i = from; i + k <= n; i++) {
+        if (foldByte((unsigned char)hay[i]) == first && equalNoCase(hay + i + 1, f + 1, k - 1)) return i;
+    }
+    return NOT_FOUND;
+}
+
+#if NOTES_SSE2
+static inline unsigned lowestBit(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long bit;
+    _BitScanForward(&bit, mask);
+    return (unsigned)bit;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+// 'A'..'Z' get 0x20 added; bytes >= 0x80 are negative as signed and stay as they are
+static inline __m128i fold16(__m128i x) {
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmplt_epi8(x, _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+static size_t findSse2(const NoCasePattern& p, const char* hay, size_t n) {
+    size_t k = p.folded.size();
+    const char* f = p.folded.data();
+    const __m128i first = _mm_set1_epi8(f[0]);
+    const __m128i last = _mm_set1_epi8(f[k - 1]);
+    size_t i = 0;
+    // candidate starts i..i+15; their last bytes end at i+15+k-1
+    for (; i + k - 1 + 16 <= n; i += 16) {
+        __m128i a = fold16(_mm_loadu_si128((const __m128i*)(hay + i)));
+        __m128i b = fold16(_mm_loadu_si128((const __m128i*)(hay + i + k - 1)));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+        while (mask) {
+            unsigned bit = lowestBit(mask);
+            if (k <= 2 || equalNoCase(hay + i + bit + 1, f + 1, k - 2)) return i + bit;
+            mask &= mask - 1;
+        }
+    }
+    return findScalar(p, hay, n, i);
+}
+#endif
+
+#if NOTES_AVX2
+__attribute__((target("avx2"))) static inline __m256i fold32(__m256i x) {
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(x, _mm256_set1_epi8('A' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), x));
+    return _mm256_or_si256(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2"))) static size_t findAvx2(const NoCasePattern& p, const char* hay, size_t n) {
+    size_t k = p.folded.size();
+    const char* f = p.folded.data();
+    const __m256i first = _mm256_set1_epi8(f[0]);
+    const __m256i last = _mm256_set1_epi8(f[k - 1]);
+    size_t i = 0;
+    for (; i + k - 1 + 32 <= n; i += 32) {
+        __m256i a = fold32(_mm256_loadu_si256((const __m256i*)(hay + i)));
+        __m256i b = fold32(_mm256_loadu_si256((const __m256i*)(hay + i + k - 1)));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+        while (mask) {
+            unsigned bit = lowestBit(mask);
+            if (k <= 2 || equalNoCase(hay + i + bit + 1, f + 1, k - 2)) return i + bit;
+            mask &= mask - 1;
+        }
+    }
+    return findScalar(p, hay, n, i);
+}
+#endif
+
+static size_t findScalarAll(const NoCasePattern& p, const char* hay, size_t n) {
+    return findScalar(p, hay, n, 0);
+}
+
+typedef size_t (*FindFn)(const NoCasePattern&, const char*, size_t);
+
+static FindFn pickFind(const char** level) {
+#if NOTES_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        *level = "avx2";
+        return findAvx2;
+    }
+#endif
+#if NOTES_SSE2
+    *level = "sse2";
+    return findSse2;
+#else
+    *level = "scalar";
+    return findScalarAll;
+#endif
+}
+
+static const char* g_simdLevel = "scalar";
+static const FindFn g_find = pickFind(&g_simdLevel);
+
+size_t findNoCase(const NoCasePattern& p, const char* hay, size_t n) {
+    size_t k = p.folded.size();
+    if (k == 0) return 0;
+    if (k > n) return NOT_FOUND;
+    return g_find(p, hay, n);
+}
+
+const char* simdLevel() {
+    return g_simdLevel;
+}
+
+std::vector<FindImpl> findImplementations() {
+    std::vector<FindImpl> v;
+    v.push_back(FindImpl{ "scalar", findScalarAll });
+#if NOTES_SSE2
+    v.push_back(FindImpl{ "sse2", findSse2 });
+#endif
+#if NOTES_AVX2
+    if (__builtin_cpu_supports("avx2")) v.push_back(FindImpl{ "avx2", findAvx2 });
+#endif
+    return v;
+}
+
+// ---------------- Unicode folding ----------------
+// kFoldTable entry + 1 for every code point below FLAT_LIMIT (0 = folds to
+// itself); the few entries above it are binary searched
+static const unsigned FLAT_LIMIT = 0x2000;
+
+static const std::vector<unsigned short>& flatFoldIndex() {
+    static const std::vector<unsigned short> index = [] {
+        std::vector<unsigned short> v(FLAT_LIMIT, 0);
+        for (size_t i = 0; i < sizeof(kFoldTable) / sizeof(kFoldTable[0]); i++) {
+            if (kFoldTable[i].cp < FLAT_LIMIT) v[kFoldTable[i].cp] = (unsigned short)(i + 1);
+        }
+        return v;
+    }();
+    return index;
+}
+
+// the folded text of cp, or nullptr if it folds to itself
+static const char* foldCodepoint(unsigned cp, const std::vector<unsigned short>& flat) {
+    if (cp < FLAT_LIMIT) {
+        unsigned short e = flat[cp];
+        return e ? kFoldTable[e - 1].folded : nullptr;
+    }
+    const FoldEntry* end = kFoldTable + sizeof(kFoldTable) / sizeof(kFoldTable[0]);
+    const FoldEntry* it = std::lower_bound(kFoldTable, end, cp,
+        [](const FoldEntry& e, unsigned c) { return e.cp < c; });
+    return (it != end && it->cp == cp) ? it->folded : nullptr;
+}
+
+static inline bool isCont(unsigned char c) {
+    return (c & 0xC0) == 0x80;
+}
+
+// code point of the 2 or 3 byte sequence at s (the table has nothing above
+// U+FFFF); 0 for anything else, which is then copied a byte at a time
+static inline unsigned decodeBmp(const unsigned char* s, size_t left, size_t& len) {
+    unsigned char c = s[0];
+    if (c >= 0xC2 && c <= 0xDF && left >= 2 && isCont(s[1])) {
+        len = 2;
+        return ((unsigned)(c & 0x1F) << 6) | (s[1] & 0x3F);
+    }
+    if (c >= 0xE0 && c <= 0xEF && left >= 3 && isCont(s[1]) && isCont(s[2])) {
+        unsigned cp = ((unsigned)(c & 0x0F) << 12) | ((unsigned)(s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+        if (cp < 0x800 || (cp >= 0xD800 && cp <= 0xDFFF)) return 0; // overlong, surrogate
+        len = 3;
+        return cp;
+    }
+    return 0;
+}
+
+// Vector: ASCII runs 16 bytes at a time (foldTextScalar turns it off, tests only)
+template <bool Vector>
+static void foldTextWith(const char* text, size_t len, std::string& out) {
+    const std::vector<unsigned short>& flat = flatFoldIndex();
+    const unsigned char* s = (const unsigned char*)text;
+    out.reserve(out.size() + len);
+    size_t i = 0;
+    while (i < len) {
+#if NOTES_SSE2
+        while (Vector && i + 16 <= len) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(s + i));
+            if (_mm_movemask_epi8(x)) break; // a byte >= 0x80
+            char folded[16];
+            _mm_storeu_si128((__m128i*)folded, fold16(x));
+            out.append(folded, 16);
+            i += 16;
+        }
+        if (i >= len) break;
+#endif
+        unsigned char c = s[i];
+        if (c < 0x80) {
+            out += (char)foldByte(c);
+            i++;
+            continue;
+        }
+        size_t n = 1;
+        unsigned cp = decodeBmp(s + i, len - i, n);
+        const char* f = cp ? foldCodepoint(cp, flat) : nullptr;
+        if (f) out += f;
+        else out.append(text + i, n);
+        i += n;
+    }
+}
+
+void foldText(const char* text, size_t len, std::string& out) {
+    foldTextWith<true>(text, len, out);
+}
+
+void foldTextScalar(const char* text, size_t len, std::string& out) {
+    foldTextWith<false>(text, len, out);
+}
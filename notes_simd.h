@@ -0,0 +1,45 @@
+// notes_simd.h
+// vectorized text kernels. findNoCase is an ASCII case-insensitive memmem,
+// the same folding LIKE does: 16 (SSE2) or 32 (AVX2) candidate positions at a
+// time are filtered by the needle's first and last byte, and only the ones
+// where both match are compared in full. AVX2 is picked at run time when the
+// CPU has it; other targets get a scalar loop with the same results.
+#pragma once
+#include <cstddef>
+#include <string>
+
+// a needle folded once, searched for many times
+struct NoCasePattern {
+    std::string folded; // ASCII lower case
+};
+
+void compileNoCase(const char* needle, size_t len, NoCasePattern& out);
+inline void compileNoCase(const std::string& needle, NoCasePattern& out) {
+    compileNoCase(needle.data(), needle.size(), out);
+}
+
+const size_t NOT_FOUND = (size_t)-1;
+
+// offset of the first match of p in hay[0, n), or NOT_FOUND; an empty pattern matches at 0
+size_t findNoCase(const NoCasePattern& p, const char* hay, size_t n);
+inline bool containsNoCase(const NoCasePattern& p, const char* hay, size_t n) {
+    return findNoCase(p, hay, n) != NOT_FOUND;
+}
+
+// ---------------- Unicode folding ----------------
+// text as search compares it: case folded and stripped of diacritics (NFKD
+// with the combining marks dropped, table in notes_fold_table.h), so "CATATAN",
+// "Čatatan" and "ｃａｔａｔａｎ" all give "catatan". covers Latin, Greek,
+// Cyrillic, Armenian, Hebrew and full-width forms; other code points and
+// invalid UTF-8 bytes are kept as they are. runs of 16 ASCII bytes are folded
+// with SSE2 at once. ASCII stays ASCII, so findNoCase on folded text with a
+// folded needle is an exact search. the result is appended to out
+void foldText(const char* text, size_t len, std::string& out);
+inline std::string foldText(const std::string& text) {
+    std::string out;
+    foldText(text.data(), text.size(), out);
+    return out;
+}
+
+// "avx2", "sse2" or "scalar": the path findNoCase takes on this machine
+const char* simdLevel();
@@ -0,0 +1,259 @@
+// notes_slowlog.cpp
+#include "notes_slowlog.h"
+#include "notes_internal.h"
+#include "notes_trace.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+// slow statements waiting for the writer; past this many, new ones are dropped
+static const size_t kMaxQueued = 64;
+
+struct SlowQuery {
+    std::string sql;     // expanded SQL, cut to maxSqlBytes
+    bool cut;
+    bool explain;        // a query or DML (EXPLAIN QUERY PLAN of DDL just fails)
+    std::string planSql; // what to explain: the expanded SQL, or the template if that was cut
+    long long ns;
+    std::time_t when;
+};
+
+static std::mutex g_slowLock;
+static std::condition_variable g_slowWake;
+static SlowLogOptions g_options;      // under g_slowLock
+static bool g_enabled = false;        // under g_slowLock
+static std::deque<SlowQuery> g_queue; // under g_slowLock
+static bool g_stop = false;           // under g_slowLock
+static std::thread g_writer;
+static long long g_thresholdNs = 0; // owner thread, set when db opens
+static size_t g_maxSqlBytes = 0;
+static std::atomic<long long> g_logged(0), g_dropped(0);
+
+void enableSlowQueryLog(const SlowLogOptions& options) {
+    std::lock_guard<std::mutex> lock(g_slowLock);
+    g_options = options;
+    g_enabled = true;
+}
+
+void disableSlowQueryLog() {
+    std::lock_guard<std::mutex> lock(g_slowLock);
+    g_enabled = false;
+}
+
+SlowLogStats slowLogStats() {
+    SlowLogStats s;
+    s.logged = g_logged;
+    s.dropped = g_dropped;
+    return s;
+}
+
+std::string slowLogPath(const std::string& dbPath) {
+    return dbPath + "-slow.log";
+}
+
+// the first max bytes of sql, not ending inside a UTF-8 sequence
+static std::string cutSql(const char* sql, size_t max, bool& cut) {
+    size_t len = std::char_traits<char>::length(sql);
+    cut = len > max;
+    if (!cut) return std::string(sql, len);
+    while (max > 0 && ((unsigned char)sql[max] & 0xC0) == 0x80) max--;
+    return std::string(sql, max);
+}
+
+// SQLite has plans for these; a schema change or PRAGMA has none worth printing
+static bool hasPlan(const char* sql) {
+    static const char* const kWords[] = { "SELECT", "WITH", "INSERT", "UPDATE", "DELETE", "REPLACE", "VALUES" };
+    while (*sql == ' ' || *sql == '\t' || *sql == '\r' || *sql == '\n' || *sql == '(') sql++;
+    for (const char* w : kWords) {
+        size_t n = std::char_traits<char>::length(w);
+        if (sqlite3_strnicmp(sql, w, (int)n) == 0) return true;
+    }
+    return false;
+}
+
+// ---------------- hook ----------------
+// runs on the thread stepping the statement, as it finishes or is reset
+static int profileHook(unsigned type, void*, void* p, void* x) {
+    if (type != SQLITE_TRACE_PROFILE) return 0;
+    long long ns = (long long)*(sqlite3_int64*)x;
+    if (ns < g_thresholdNs) return 0;
+
+    sqlite3_stmt* stmt = (sqlite3_stmt*)p;
+    SlowQuery q;
+    q.ns = ns;
+    q.when = std::time(nullptr);
+    // expanding can fail (out of memory, past SQLITE_LIMIT_LENGTH): the template then
+    char* expanded = sqlite3_expanded_sql(stmt);
+    const char* sql = expanded ? expanded : sqlite3_sql(stmt);
+    q.sql = cutSql(sql ? sql : "", g_maxSqlBytes, q.cut);
+    q.planSql = q.cut ? sqlite3_sql(stmt) : q.sql;
+    q.explain = hasPlan(sqlite3_sql(stmt));
+    sqlite3_free(expanded);
+
+    std::lock_guard<std::mutex> lock(g_slowLock);
+    if (g_queue.size() >= kMaxQueued) {
+        g_dropped++;
+        return 0;
+    }
+    g_queue.push_back(std::move(q));
+    g_slowWake.notify_one();
+    return 0;
+}
+
+// ---------------- writer ----------------
+// the plan as SQLite prints it in the shell: one line per step, nested by parent
+static void appendPlan(std::string& out, sqlite3* conn, const std::string& sql) {
+    sqlite3_stmt* stmt = nullptr;
+    std::string eqp = "EXPLAIN QUERY PLAN " + sql;
+    if (!conn || sqlite3_prepare_v2(conn, eqp.c_str(), (int)eqp.size(), &stmt, nullptr) != SQLITE_OK) {
+        out += "  (no plan: ";
+        out += conn ? sqlite3_errmsg(conn) : "cannot open the database";
+        out += ")\n";
+        sqlite3_finalize(stmt);
+        return;
+    }
+    std::map<int, int> depth; // step id -> nesting
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        int id = sqlite3_column_int(stmt, 0);
+        int d = depth[sqlite3_column_int(stmt, 1)] + 1;
+        depth[id] = d;
+        out.append(2 * d, ' ');
+        const unsigned char* detail = sqlite3_column_text(stmt, 3);
+        out += detail ? (const char*)detail : "";
+        out += '\n';
+    }
+    sqlite3_finalize(stmt);
+}
+
+static std::string formatEntry(const SlowQuery& q, sqlite3* conn) {
+    std::tm tm = {};
+#ifdef _WIN32
+    localtime_s(&tm, &q.when);
+#else
+    localtime_r(&q.when, &tm);
+#endif
+    char head[64];
+    size_t n = std::strftime(head, sizeof(head), "%Y-%m-%d %H:%M:%S", &tm);
+    std::snprintf(head + n, sizeof(head) - n, "  %lld ms\n", q.ns / 1000000);
+    std::string out = head;
+    out += q.sql;
+    if (q.cut) out += " ...";
+    out += '\n';
+    if (q.explain) appendPlan(out, conn, q.planSql);
+    out += '\n';
+    return out;
+}
+
+static FILE* openLog(const fs::path& path) {
+#ifdef _WIN32
+    return _wfopen(path.c_str(), L"ab");
+#else
+    return std::fopen(path.c_str(), "ab");
+#endif
+}
+
+// -slow.log -> .1 -> .2 ... up to keep; the oldest is removed
+static void rotate(const fs::path& path, int keep) {
+    std::error_code ec;
+    auto numbered = [&](int i) {
+        fs::path p = path;
+        p += "." + std::to_string(i);
+        return p;
+    };
+    if (keep <= 0) {
+        fs::remove(path, ec);
+        return;
+    }
+    fs::remove(numbered(keep), ec);
+    for (int i = keep - 1; i >= 1; i--) fs::rename(numbered(i), numbered(i + 1), ec);
+    fs::rename(path, numbered(1), ec);
+}
+
+static void writerMain(std::string dbPath, SlowLogOptions options) {
+    TRACE_THREAD_NAME("slow log");
+    fs::path path = fs::u8path(slowLogPath(dbPath));
+    sqlite3* conn = nullptr; // for the plans, opened with the first slow statement
+    bool triedOpen = false;
+    FILE* f = nullptr;
+    unsigned long long size = 0;
+    for (;;) {
+        SlowQuery q;
+        {
+            std::unique_lock<std::mutex> lock(g_slowLock);
+            g_slowWake.wait(lock, [] { return !g_queue.empty() || g_stop; });
+            if (g_queue.empty()) break; // stopping, and everything is written
+            q = std::move(g_queue.front());
+            g_queue.pop_front();
+        }
+        if (!triedOpen) {
+            triedOpen = true;
+            if (sqlite3_open_v2(dbPath.c_str(), &conn, SQLITE_OPEN_READONLY, nullptr) == SQLITE_OK) {
+                sqlite3_busy_timeout(conn, 1000);
+                registerSqlFunctions(conn);
+            } else {
+                sqlite3_close(conn);
+                conn = nullptr;
+            }
+        }
+        std::string entry = formatEntry(q, conn);
+
+        if (!f) {
+            f = openLog(path);
+            std::error_code ec;
+            size = f ? fs::file_size(path, ec) : 0;
+            if (ec) size = 0;
+        }
+        if (f && size > 0 && size + entry.size() > options.maxFileBytes) {
+            std::fclose(f); // Windows does not rename open files
+            rotate(path, options.keepFiles);
+            f = openLog(path);
+            size = 0;
+        }
+        if (f && std::fwrite(entry.data(), 1, entry.size(), f) == entry.size() && std::fflush(f) == 0) {
+            size += entry.size();
+            g_logged++;
+        } else {
+            g_dropped++;
+        }
+    }
+    if (f) std::fclose(f);
+    sqlite3_close(conn);
+}
+
+// ---------------- connection ----------------
+void openSlowQueryLog() {
+    SlowLogOptions options;
+    {
+        std::lock_guard<std::mutex> lock(g_slowLock);
+        if (!g_enabled) return;
+        options = g_options;
+        g_queue.clear();
+        g_stop = false;
+    }
+    // in-memory databases have nowhere to put the log
+    const char* file = sqlite3_db_filename(db, "main");
+    if (!file || !*file || g_writer.joinable()) return;
+    g_thresholdNs = (long long)options.thresholdMs * 1000000;
+    g_maxSqlBytes = options.maxSqlBytes;
+    g_writer = std::thread(writerMain, std::string(file), options);
+    sqlite3_trace_v2(db, SQLITE_TRACE_PROFILE, profileHook, nullptr);
+}
+
+void closeSlowQueryLog() {
+    if (db) sqlite3_trace_v2(db, 0, nullptr, nullptr);
+    if (!g_writer.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(g_slowLock);
+        g_stop = true;
+        g_slowWake.notify_one();
+    }
+    g_writer.join();
+}
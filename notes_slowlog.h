@@ -0,0 +1,39 @@
+// notes_slowlog.h
+// slow-query log: every statement of the main connection that takes at least
+// thresholdMs (SQLite's own timing, sqlite3_trace_v2 SQLITE_TRACE_PROFILE: from
+// its first step to its reset, whole milliseconds on most systems) is written with its SQL, parameters filled in,
+// and its EXPLAIN QUERY PLAN to <database file>-slow.log:
+//
+//   2026-10-16 14:03:12  312 ms
+//   SELECT id, title, preview FROM notes WHERE content LIKE '%rapat%' ...
+//     SCAN notes
+//     USE TEMP B-TREE FOR ORDER BY
+//
+// off unless enabled. the hook only compares a duration; the SQL is copied
+// only for slow statements, and the plan is looked up and written by a
+// background thread on its own read-only connection. past maxFileBytes the
+// file is renamed to -slow.log.1 (.1 to .2, ...) and a new one started.
+// the log holds bound values, i.e. note text: it is for your own machine.
+#pragma once
+#include <string>
+
+struct SlowLogOptions {
+    int thresholdMs = 100;
+    unsigned long long maxFileBytes = 1u << 20; // per file
+    int keepFiles = 3;                          // rotated files kept besides the current one
+    size_t maxSqlBytes = 4096;                  // longer SQL is cut (bound note text)
+};
+
+// takes effect when the database is next opened (set it before initDatabase /
+// startDbWorker, like the profile)
+void enableSlowQueryLog(const SlowLogOptions& options);
+void disableSlowQueryLog();
+
+struct SlowLogStats {
+    long long logged;  // statements written
+    long long dropped; // slow statements not written (writer too far behind, or the file failed)
+};
+SlowLogStats slowLogStats();
+
+// the log file of the database at dbPath
+std::string slowLogPath(const std::string& dbPath);
@@ -0,0 +1,280 @@
+// notes_test.cpp
+// headless checks of the pure parts of the library (no database, no window),
+// run by ctest. every failed check prints where it was; the exit code is 1 if
+// any failed.
+//
+//   notes_test
+#include "notes_internal.h"
+#include "notes_layout.h"
+#include "notes_simd.h"
+#include <cstdio>
+#include <random>
+#include <string>
+
+static int g_failures = 0;
+
+#define CHECK(cond) check((cond), #cond, __FILE__, __LINE__, "")
+#define CHECK_MSG(cond, msg) check((cond), #cond, __FILE__, __LINE__, (msg))
+
+static void check(bool ok, const char* expr, const char* file, int line, const std::string& msg) {
+    if (ok) return;
+    g_failures++;
+    std::fprintf(stderr, "%s:%d: failed: %s %s\n", file, line, expr, msg.c_str());
+}
+
+// ---------------- layout ----------------
+static bool intersects(const GridRect& r, int scrollY, int viewH) {
+    return r.bottom > scrollY && r.top < scrollY + viewH;
+}
+
+// what visibleRange promises: every card that intersects the viewport is in
+// [first, last), and nothing in it is further than the gap below a row away
+static void checkVisible(const GridLayout& g, size_t count, int scrollY, int viewH) {
+    size_t first = 0, last = 0;
+    visibleRange(g, count, scrollY, viewH, &first, &last);
+    std::string where = "count=" + std::to_string(count) + " scrollY=" + std::to_string(scrollY) +
+                        " viewH=" + std::to_string(viewH) + " columns=" + std::to_string(g.columns);
+    CHECK_MSG(first <= last && last <= count, where);
+    for (size_t i = 0; i < count; i++) {
+        GridRect r = cardRect(g, i);
+        if (intersects(r, scrollY, viewH)) CHECK_MSG(i >= first && i < last, where + " i=" + std::to_string(i));
+    }
+    for (size_t i = first; i < last; i++) {
+        GridRect r = cardRect(g, i);
+        CHECK_MSG(r.bottom + g.margin > scrollY && r.top < scrollY + viewH, where + " i=" + std::to_string(i));
+    }
+}
+
+// cardAt against a walk over every card's rectangle
+static long cardAtSlow(const GridLayout& g, size_t count, int x, int y) {
+    for (size_t i = 0; i < count; i++) {
+        GridRect r = cardRect(g, i);
+        if (x >= r.left && x < r.right && y >= r.top && y < r.bottom) return (long)i;
+    }
+    return -1;
+}
+
+static void testLayout() {
+    GridLayout g;
+    g.margin = 10;
+    g.cardW = 180;
+    g.cardH = 110;
+
+    layoutForWidth(g, 0);
+    CHECK(g.columns == 1);
+    layoutForWidth(g, 2 * (g.cardW + g.margin) + g.margin - 1);
+    CHECK(g.columns == 1);
+    layoutForWidth(g, 2 * (g.cardW + g.margin) + g.margin);
+    CHECK(g.columns == 2);
+
+    // zero cards
+    size_t first = 1, last = 1;
+    visibleRange(g, 0, 0, 500, &first, &last);
+    CHECK(first == 0 && last == 0);
+    CHECK(cardAt(g, 0, g.margin, g.margin) == -1);
+    CHECK(contentHeight(g, 0) == g.margin);
+    CHECK(clampScroll(g, 0, 100, 500) == 0);
+    CHECK(clampScroll(g, 0, -5, 500) == 0);
+
+    // row and column boundaries, with full and partial last rows; every
+    // scroll offset through two row pitches and a bit past the end
+    int pitch = g.cardH + g.margin;
+    for (int columns = 1; columns <= 4; columns++) {
+        g.columns = columns;
+        for (size_t count : { (size_t)1, (size_t)columns, (size_t)columns * 3, (size_t)columns * 3 + 1 }) {
+            int height = contentHeight(g, count);
+            for (int scrollY = -pitch; scrollY <= height + pitch; scrollY++) {
+                checkVisible(g, count, scrollY, 1);
+                checkVisible(g, count, scrollY, g.cardH);
+                checkVisible(g, count, scrollY, pitch * 2 + 3);
+            }
+            int width = g.margin + columns * (g.cardW + g.margin) + 20;
+            for (int y = -1; y <= height + 5; y++) {
+                for (int x = -1; x <= width; x++) {
+                    long want = cardAtSlow(g, count, x, y);
+                    if (cardAt(g, count, x, y) != want) {
+                        CHECK_MSG(cardAt(g, count, x, y) == want,
+                                  "x=" + std::to_string(x) + " y=" + std::to_string(y) + " count=" + std::to_string(count));
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // a partial last row: its empty slots are gaps, not cards
+    g.columns = 3;
+    GridRect slot = cardRect(g, 4);
+    CHECK(cardAt(g, 4, slot.left, slot.top) == -1);
+    CHECK(cardAt(g, 5, slot.left, slot.top) == 4);
+    visibleRange(g, 4, 0, 10000, &first, &last);
+    CHECK(first == 0 && last == 4);
+
+    // clamping after a resize: scrolled to the end of a narrow window, then
+    // widened so the content gets shorter
+    size_t count = 100;
+    int viewH = 600;
+    layoutForWidth(g, 400);
+    int scrollY = clampScroll(g, count, 1 << 30, viewH);
+    CHECK(scrollY == contentHeight(g, count) - viewH);
+    layoutForWidth(g, 2000);
+    int clamped = clampScroll(g, count, scrollY, viewH);
+    CHECK(clamped == contentHeight(g, count) - viewH);
+    CHECK(clamped < scrollY);
+    layoutForWidth(g, 100000); // everything in one row, shorter than the view
+    CHECK(clampScroll(g, count, scrollY, viewH) == 0);
+}
+
+// ---------------- SIMD search ----------------
+static unsigned char lowerAscii(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c | 0x20) : c;
+}
+
+static size_t findNaive(const std::string& needle, const std::string& hay) {
+    if (needle.size() > hay.size()) return NOT_FOUND;
+    for (size_t i = 0; i + needle.size() <= hay.size(); i++) {
+        size_t j = 0;
+        while (j < needle.size() && lowerAscii((unsigned char)hay[i + j]) == lowerAscii((unsigned char)needle[j])) j++;
+        if (j == needle.size()) return i;
+    }
+    return NOT_FOUND;
+}
+
+// bytes around the edges of 'A'..'Z' and their images >= 0x80 (signed compares)
+static const char kSearchBytes[] = { 'a', 'A', 'b', 'B', 'z', 'Z', '@', '[', '`', '{', ' ',
+                                     (char)0xC1, (char)0xE1, (char)0xDA, (char)0x80, (char)0xFF };
+
+static std::string randomText(std::mt19937& rng, size_t n, size_t alphabet) {
+    std::string s(n, ' ');
+    for (char& c : s) c = kSearchBytes[rng() % alphabet];
+    return s;
+}
+
+static void checkFind(const FindImpl& impl, const std::string& needle, const std::string& hay) {
+    NoCasePattern p;
+    compileNoCase(needle, p);
+    size_t want = findNaive(needle, hay);
+    size_t got = needle.size() <= hay.size() ? impl.find(p, hay.data(), hay.size()) : NOT_FOUND;
+    CHECK_MSG(got == want, std::string(impl.name) + " needle=" + std::to_string(needle.size()) + " bytes hay=" +
+                               std::to_string(hay.size()) + " bytes want=" + std::to_string((long long)want) +
+                               " got=" + std::to_string((long long)got));
+    CHECK(findNoCase(p, hay.data(), hay.size()) == want);
+}
+
+static void testFindNoCase() {
+    std::vector<FindImpl> impls = findImplementations();
+    std::printf("findNoCase variants:");
+    for (auto& impl : impls) std::printf(" %s", impl.name);
+    std::printf("\n");
+    std::mt19937 rng(1);
+    for (auto& impl : impls) {
+        // random text over a few letters, so matches and near misses are common
+        for (int round = 0; round < 20000; round++) {
+            size_t alphabet = round % 2 ? 4 : sizeof(kSearchBytes);
+            std::string hay = randomText(rng, rng() % 100, alphabet);
+            size_t k = 1 + rng() % 6;
+            std::string needle;
+            if (hay.size() >= k && rng() % 2) {
+                // a piece of hay with some letters' case flipped
+                needle = hay.substr(rng() % (hay.size() - k + 1), k);
+                for (char& c : needle) {
+                    if (rng() % 2 && ((c | 0x20) >= 'a' && (c | 0x20) <= 'z')) c ^= 0x20;
+                }
+            } else {
+                needle = randomText(rng, k, alphabet);
+            }
+            checkFind(impl, needle, hay);
+        }
+        // one match at every position of haystacks up to three 32-byte blocks
+        // long: it starts in a block, straddles into the tail, or sits in it
+        for (size_t k = 1; k <= 5; k++) {
+            for (size_t n = k; n <= 100; n++) {
+                for (size_t at = 0; at + k <= n; at++) {
+                    std::string hay(n, 'x');
+                    std::string needle = std::string("QuErY").substr(0, k);
+                    hay.replace(at, k, "qUeRy", k);
+                    checkFind(impl, needle, hay);
+                }
+                // first and last byte match everywhere, the middle never does
+                if (k >= 3) checkFind(impl, "q" + std::string(k - 2, 'u') + "q", std::string(n, 'q'));
+            }
+        }
+        // bytes >= 0x80 next to letters: 0xC1 is not 'A' | 0x80 folded
+        checkFind(impl, "a", std::string("\xC1\xE1") + std::string(40, '\xC1'));
+        checkFind(impl, "\xE1", std::string(40, 'A') + "\xC1");
+        checkFind(impl, "\xC1" "b", std::string(33, '\xE1') + "\xC1" "B");
+    }
+}
+
+// ---------------- Unicode folding ----------------
+// foldText, and the same without the SSE2 ASCII runs: both must give want
+static void checkFold(const std::string& text, const std::string& want) {
+    std::string simd = foldText(text);
+    std::string scalar;
+    foldTextScalar(text.data(), text.size(), scalar);
+    CHECK_MSG(simd == want, "\"" + text + "\" -> \"" + simd + "\", want \"" + want + "\"");
+    CHECK_MSG(scalar == want, "\"" + text + "\" -> \"" + scalar + "\" (scalar), want \"" + want + "\"");
+}
+
+static void testFoldText() {
+    checkFold("", "");
+    checkFold("CATATAN", "catatan");
+    checkFold("catatan", "catatan");
+    checkFold("Zürich", "zurich");
+    checkFold("Straße", "strasse");
+    checkFold("Čatatan", "catatan");
+    checkFold("ｃａｔａｔａｎ", "catatan");
+    checkFold("ΑΘΗΝΑ", "αθηνα");
+    checkFold("ΆΛΦΑ", "αλφα");
+    checkFold("МОСКВА", "москва");
+    checkFold("ЁЖИК", "ежик");
+    // full-width % and _ become the ASCII ones (searchSql escapes them)
+    checkFold("１００％＿", "100%_");
+
+    // one non-ASCII letter at every offset of the first two 16-byte runs, and
+    // ASCII of every length after it
+    for (size_t before = 0; before <= 33; before++) {
+        for (size_t after : { (size_t)0, (size_t)1, (size_t)15, (size_t)16, (size_t)17 }) {
+            std::string text = std::string(before, 'Q') + "Ü" + std::string(after, 'W');
+            checkFold(text, std::string(before, 'q') + "u" + std::string(after, 'w'));
+        }
+    }
+
+    // invalid UTF-8 is kept byte for byte, the ASCII around it is still folded
+    checkFold("A\x80" "B", "a\x80" "b");              // lone continuation byte
+    checkFold("AB\xC3", "ab\xC3");                 // cut off at the end
+    checkFold("\xC3" "A", "\xC3" "a");             // lead byte without continuation
+    checkFold("\xC0\xAF" "A", "\xC0\xAF" "a");   // overlong '/'
+    checkFold("\xED\xA0\x80" "A", "\xED\xA0\x80" "a"); // surrogate
+    checkFold("\xF0\x9F\x98\x80" "A", "\xF0\x9F\x98\x80" "a"); // beyond U+FFFF: kept
+    std::string runs = std::string(20, 'A') + "\xFF" + std::string(20, 'B');
+    checkFold(runs, std::string(20, 'a') + "\xFF" + std::string(20, 'b'));
+
+    // random bytes and random mixes of ASCII and multi-byte letters: the two
+    // paths agree
+    static const char* const kPieces[] = { "A", "z", "Q", " ", "%", "Ä", "ß", "Σ", "Ж", "Ｍ", "\xC3", "\x80", "\xFF" };
+    std::mt19937 rng(2);
+    for (int round = 0; round < 5000; round++) {
+        std::string text;
+        size_t n = rng() % 80;
+        if (round % 2) {
+            for (size_t i = 0; i < n; i++) text += (char)(rng() & 0xFF);
+        } else {
+            for (size_t i = 0; i < n; i++) text += kPieces[rng() % (sizeof(kPieces) / sizeof(kPieces[0]))];
+        }
+        std::string simd = foldText(text);
+        std::string scalar;
+        foldTextScalar(text.data(), text.size(), scalar);
+        CHECK_MSG(simd == scalar, "random text of " + std::to_string(text.size()) + " bytes");
+    }
+}
+
+// ---------------- main ----------------
+int main() {
+    testLayout();
+    testFindNoCase();
+    testFoldText();
+    if (g_failures) std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+    else std::printf("all checks passed\n");
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,208 @@
+// notes_trace.cpp
+#include "notes_trace.h"
+#ifdef NOTES_TRACE
+#include "notes_export.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// one span; the fields are atomics only so a dump running next to the
+// recording thread is well defined (relaxed stores are plain stores)
+struct TraceEvent {
+    std::atomic<const char*> name;
+    std::atomic<const char*> detail;
+    std::atomic<long long> value;
+    std::atomic<long long> startNs;
+    std::atomic<long long> durNs;
+};
+
+// written by its thread only; count is published after the slot is filled
+struct TraceRing {
+    std::unique_ptr<TraceEvent[]> events;
+    size_t size = 0;
+    std::atomic<unsigned long long> count{ 0 }; // spans ever recorded
+    std::atomic<const char*> threadName{ nullptr };
+    int tid = 0;
+};
+
+// a ring outlives its thread (a dump can still show threads that are gone)
+// until a new thread takes it over from g_freeRings, so pools that come and go
+// reuse the same few rings; past kMaxRings live threads nothing more is
+// recorded. rings are only handed over under g_ringsLock, which a dump holds
+static const size_t kMaxRings = 256;
+static std::mutex g_ringsLock;
+static std::vector<TraceRing*> g_rings;     // under g_ringsLock
+static std::vector<TraceRing*> g_freeRings; // under g_ringsLock, threads gone
+static size_t g_ringEvents = TRACE_RING_EVENTS; // under g_ringsLock, for rings handed out next
+static int g_lastTid = 0;                   // under g_ringsLock
+static thread_local TraceRing* t_ring = nullptr;
+static thread_local bool t_noRing = false;
+
+// gives the thread's ring back when the thread exits
+struct TraceRingOwner {
+    ~TraceRingOwner() {
+        if (!t_ring) return;
+        std::lock_guard<std::mutex> lock(g_ringsLock);
+        g_freeRings.push_back(t_ring);
+        t_ring = nullptr;
+        t_noRing = true; // spans from later thread_local destructors
+    }
+};
+static thread_local TraceRingOwner t_ringOwner;
+
+static const std::chrono::steady_clock::time_point g_traceBase = std::chrono::steady_clock::now();
+
+static long long traceNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_traceBase).count();
+}
+
+static TraceRing* threadRing() {
+    if (t_ring || t_noRing) return t_ring;
+    std::lock_guard<std::mutex> lock(g_ringsLock);
+    TraceRing* r;
+    if (!g_freeRings.empty()) {
+        r = g_freeRings.back();
+        g_freeRings.pop_back();
+        r->count.store(0, std::memory_order_relaxed);
+        r->threadName = nullptr;
+    } else if (g_rings.size() < kMaxRings) {
+        r = new TraceRing();
+        g_rings.push_back(r);
+    } else {
+        t_noRing = true;
+        return nullptr;
+    }
+    if (r->size != g_ringEvents) {
+        r->events.reset(new TraceEvent[g_ringEvents]);
+        r->size = g_ringEvents;
+    }
+    r->tid = ++g_lastTid; // its own row in the viewer
+    (void)&t_ringOwner;   // odr-use: constructs the owner for this thread
+    t_ring = r;
+    return r;
+}
+
+void setTraceRingEvents(size_t events) {
+    std::lock_guard<std::mutex> lock(g_ringsLock);
+    g_ringEvents = events > 0 ? events : 1;
+}
+
+TraceScope::TraceScope(const char* name, const char* detail, long long value)
+    : name(name), detail(detail), value(value), startNs(traceNowNs()) {}
+
+TraceScope::~TraceScope() {
+    if (!name) return;
+    long long end = traceNowNs();
+    TraceRing* r = threadRing();
+    if (!r) return;
+    unsigned long long n = r->count.load(std::memory_order_relaxed);
+    TraceEvent& e = r->events[n % r->size];
+    e.name.store(name, std::memory_order_relaxed);
+    e.detail.store(detail, std::memory_order_relaxed);
+    e.value.store(value, std::memory_order_relaxed);
+    e.startNs.store(startNs, std::memory_order_relaxed);
+    e.durNs.store(end - startNs, std::memory_order_relaxed);
+    r->count.store(n + 1, std::memory_order_release);
+}
+
+void setTraceThreadName(const char* name) {
+    TraceRing* r = threadRing();
+    if (r) r->threadName = name;
+}
+
+// ---------------- dump ----------------
+struct TraceCopy {
+    const char* name;
+    const char* detail;
+    long long value, startNs, durNs;
+};
+
+// the ring's spans, oldest first, without the ones overwritten while copying
+static void copyRing(TraceRing* r, std::vector<TraceCopy>& out) {
+    out.clear();
+    unsigned long long size = r->size;
+    unsigned long long end = r->count.load(std::memory_order_acquire);
+    unsigned long long begin = end > size ? end - size : 0;
+    for (unsigned long long i = begin; i < end; i++) {
+        TraceEvent& e = r->events[i % size];
+        out.push_back(TraceCopy{ e.name.load(std::memory_order_relaxed), e.detail.load(std::memory_order_relaxed),
+                                 e.value.load(std::memory_order_relaxed), e.startNs.load(std::memory_order_relaxed),
+                                 e.durNs.load(std::memory_order_relaxed) });
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // the slot of span number `now` may be half written, and it is the slot of
+    // now - size: everything up to that one is suspect
+    unsigned long long now = r->count.load(std::memory_order_relaxed);
+    if (now >= begin + size) {
+        size_t stale = (size_t)std::min<unsigned long long>(now - size + 1 - begin, out.size());
+        out.erase(out.begin(), out.begin() + stale);
+    }
+}
+
+static void appendMicros(std::string& out, long long ns) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%lld.%03lld", ns / 1000, ns % 1000);
+    out += buf;
+}
+
+bool writeTrace(const std::string& file, std::string& err) {
+    // held for the whole dump: no ring changes hands while it is read. a thread
+    // recording its first span waits, everyone else keeps going
+    std::lock_guard<std::mutex> lock(g_ringsLock);
+    FILE* f = std::fopen(file.c_str(), "wb");
+    if (!f) {
+        err = file + ": cannot create";
+        return false;
+    }
+    bool ok = true;
+    std::string buf = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    std::vector<TraceCopy> spans;
+    for (TraceRing* r : g_rings) {
+        std::string tid = std::to_string(r->tid);
+        const char* threadName = r->threadName;
+        if (threadName) {
+            buf += first ? "\n" : ",\n";
+            first = false;
+            buf += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":";
+            appendJsonString(buf, threadName, std::char_traits<char>::length(threadName));
+            buf += "}}";
+        }
+        copyRing(r, spans);
+        for (auto& s : spans) {
+            buf += first ? "\n" : ",\n";
+            first = false;
+            buf += "{\"ph\":\"X\",\"pid\":1,\"tid\":" + tid + ",\"name\":";
+            appendJsonString(buf, s.name, std::char_traits<char>::length(s.name));
+            buf += ",\"ts\":";
+            appendMicros(buf, s.startNs);
+            buf += ",\"dur\":";
+            appendMicros(buf, s.durNs);
+            if (s.detail || s.value) {
+                buf += ",\"args\":{";
+                if (s.detail) {
+                    buf += "\"detail\":";
+                    appendJsonString(buf, s.detail, std::char_traits<char>::length(s.detail));
+                    buf += ",";
+                }
+                buf += "\"value\":" + std::to_string(s.value) + "}";
+            }
+            buf += "}";
+            if (buf.size() >= (1u << 20)) {
+                ok = ok && std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+                buf.clear();
+            }
+        }
+    }
+    buf += "\n]}\n";
+    ok = ok && std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+    if (std::fclose(f) != 0) ok = false;
+    if (!ok) err = file + ": write failed";
+    return ok;
+}
+
+#endif
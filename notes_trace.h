@@ -0,0 +1,65 @@
+// notes_trace.h
+// nested timing spans, dumped as Chrome trace-event JSON (chrome://tracing,
+// ui.perfetto.dev) to see where one keystroke's time goes across the UI
+// thread, the db worker and the background threads:
+//
+//   void fetchSomething() {
+//       TRACE_SCOPE("fetchSomething");
+//       ...
+//   }
+//
+// every thread records into its own ring buffer (the newest TRACE_RING_EVENTS
+// spans are kept, see setTraceRingEvents), so a span costs two clock reads and
+// a few stores, no lock. a thread's ring is reused by a later thread once it exits.
+// only built with NOTES_TRACE defined (cmake -DNOTES_TRACE=ON); otherwise the
+// macros expand to nothing and writeTrace just says so.
+#pragma once
+#include <cstddef>
+#include <string>
+
+const int TRACE_RING_EVENTS = 65536; // per thread, default (40 bytes each)
+
+#ifdef NOTES_TRACE
+
+struct TraceScope {
+    // name and detail must outlive the dump (string literals); a null name
+    // records nothing
+    explicit TraceScope(const char* name, const char* detail = nullptr, long long value = 0);
+    ~TraceScope();
+    const char* name;
+    const char* detail;
+    long long value;
+    long long startNs;
+};
+
+#define TRACE_JOIN2(a, b) a##b
+#define TRACE_JOIN(a, b) TRACE_JOIN2(a, b)
+// span from here to the end of the enclosing block
+#define TRACE_SCOPE(name) TraceScope TRACE_JOIN(traceScope_, __LINE__)(name)
+// same, with args {"detail": detail, "value": value} in the viewer
+#define TRACE_SCOPE_DETAIL(name, detail, value) TraceScope TRACE_JOIN(traceScope_, __LINE__)(name, detail, value)
+// label for the calling thread's row in the viewer
+#define TRACE_THREAD_NAME(name) setTraceThreadName(name)
+
+void setTraceThreadName(const char* name);
+// spans kept per thread, for threads that record their first span after this
+void setTraceRingEvents(size_t events);
+// write every thread's buffered spans to file; recording goes on meanwhile
+bool writeTrace(const std::string& file, std::string& err);
+
+#else
+
+// arguments are not evaluated (sizeof only keeps helpers like a message-name
+// lookup from counting as unused)
+#define TRACE_SCOPE(name) ((void)sizeof(name))
+#define TRACE_SCOPE_DETAIL(name, detail, value) ((void)sizeof((name), (detail), (value)))
+#define TRACE_THREAD_NAME(name) ((void)sizeof(name))
+
+inline void setTraceRingEvents(size_t) {}
+
+inline bool writeTrace(const std::string&, std::string& err) {
+    err = "built without NOTES_TRACE";
+    return false;
+}
+
+#endif
@@ -0,0 +1,355 @@
+// notes_watchdog.cpp
+#include "notes_watchdog.h"
+#include "notes_trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+static const std::chrono::steady_clock::time_point g_watchdogBase = std::chrono::steady_clock::now();
+
+static long long watchdogNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_watchdogBase)
+        .count();
+}
+
+// ---------------- UI thread state ----------------
+// written by the UI thread only. g_beatSeq is odd while it changes the frames,
+// so the watchdog can tell a consistent look from a torn one (and it names
+// the stretch between two heartbeats)
+struct WatchdogFrame {
+    std::atomic<unsigned> code;
+    std::atomic<const char*> name;
+    std::atomic<const char*> handler;
+    std::atomic<bool> waiting;
+};
+
+static WatchdogFrame g_frames[WATCHDOG_MAX_DEPTH];
+static std::atomic<int> g_depth(0);
+static std::atomic<long long> g_beatNs(0);
+static std::atomic<unsigned long long> g_beatSeq(0);
+static std::atomic<long long> g_dispatches(0);
+
+static std::atomic<bool> g_running(false);
+static std::atomic<long long> g_thresholdNs(0);
+
+// ---------------- db side ----------------
+static std::atomic<const char*> g_dbWhat(nullptr);
+static std::atomic<long long> g_dbValue(0);
+static std::atomic<long long> g_dbSinceNs(0);
+
+DbActivityScope::DbActivityScope(const char* what, long long value)
+    : prevWhat(g_dbWhat.load(std::memory_order_relaxed)), prevValue(g_dbValue.load(std::memory_order_relaxed)),
+      prevSinceNs(g_dbSinceNs.load(std::memory_order_relaxed)) {
+    g_dbValue.store(value, std::memory_order_relaxed);
+    g_dbSinceNs.store(watchdogNowNs(), std::memory_order_relaxed);
+    g_dbWhat.store(what, std::memory_order_release);
+}
+
+DbActivityScope::~DbActivityScope() {
+    g_dbValue.store(prevValue, std::memory_order_relaxed);
+    g_dbSinceNs.store(prevSinceNs, std::memory_order_relaxed);
+    g_dbWhat.store(prevWhat, std::memory_order_release);
+}
+
+// ---------------- stalls ----------------
+struct SiteTally {
+    StallSite site;
+    std::map<std::string, long long> db;
+};
+
+// what the watchdog caught during the stretch after heartbeat seq
+struct CaughtStall {
+    unsigned long long seq = ~0ull; // ~0: nothing caught
+    unsigned code = 0;
+    const char* name = nullptr;
+    const char* handler = nullptr;
+    long long startNs = 0;
+    std::string db; // activity name, for the tally
+    std::string dbDetail;
+};
+
+static std::mutex g_reportLock;
+static std::map<std::pair<unsigned, std::string>, SiteTally> g_sites; // under g_reportLock
+static CaughtStall g_caught;                                          // under g_reportLock
+static long long g_stalls = 0;                                        // under g_reportLock
+static double g_stalledMs = 0;                                        // under g_reportLock
+static std::string g_reportFile;                                      // under g_reportLock
+
+// the stretch since the last heartbeat was a stall of the top frame: tally it
+static void recordStall(const WatchdogFrame& f, long long gapNs) {
+    double ms = gapNs / 1e6;
+    const char* handler = f.handler.load(std::memory_order_relaxed);
+    unsigned code = f.code.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(g_reportLock);
+    SiteTally& t = g_sites[std::make_pair(code, std::string(handler ? handler : ""))];
+    if (t.site.stalls == 0) {
+        t.site.code = code;
+        t.site.message = f.name.load(std::memory_order_relaxed);
+        t.site.handler = handler;
+    }
+    t.site.stalls++;
+    t.site.totalMs += ms;
+    t.site.maxMs = std::max(t.site.maxMs, ms);
+    bool caught = g_caught.seq == g_beatSeq.load(std::memory_order_relaxed);
+    t.db[caught ? g_caught.db : "unseen"]++;
+    g_caught.seq = ~0ull;
+    g_stalls++;
+    g_stalledMs += ms;
+}
+
+// a heartbeat at now: what ran since the last one may have been a stall
+static void checkGap(long long now) {
+    int depth = g_depth.load(std::memory_order_relaxed);
+    if (depth <= 0 || depth > WATCHDOG_MAX_DEPTH) return;
+    const WatchdogFrame& top = g_frames[depth - 1];
+    long long gap = now - g_beatNs.load(std::memory_order_relaxed);
+    if (!top.waiting.load(std::memory_order_relaxed) && gap >= g_thresholdNs.load(std::memory_order_relaxed)) {
+        recordStall(top, gap);
+    }
+}
+
+static void beginChange() {
+    g_beatSeq.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+static void endChange(long long now) {
+    g_beatNs.store(now, std::memory_order_relaxed);
+    g_beatSeq.fetch_add(1, std::memory_order_release);
+}
+
+WatchdogDispatch::WatchdogDispatch(unsigned code, const char* name, const char* handler)
+    : active(g_running.load(std::memory_order_relaxed)) {
+    if (!active) return;
+    long long now = watchdogNowNs();
+    checkGap(now);
+    g_dispatches.fetch_add(1, std::memory_order_relaxed);
+    beginChange();
+    int depth = g_depth.load(std::memory_order_relaxed);
+    if (depth < WATCHDOG_MAX_DEPTH) {
+        WatchdogFrame& f = g_frames[depth];
+        f.code.store(code, std::memory_order_relaxed);
+        f.name.store(name, std::memory_order_relaxed);
+        f.handler.store(handler, std::memory_order_relaxed);
+        f.waiting.store(false, std::memory_order_relaxed);
+    }
+    g_depth.store(depth + 1, std::memory_order_relaxed);
+    endChange(now);
+}
+
+WatchdogDispatch::~WatchdogDispatch() {
+    if (!active) return;
+    long long now = watchdogNowNs();
+    checkGap(now);
+    beginChange();
+    g_depth.store(g_depth.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+    endChange(now);
+}
+
+static void setWaiting(int frame, bool waiting) {
+    long long now = watchdogNowNs();
+    checkGap(now);
+    beginChange();
+    if (frame >= 0 && frame < WATCHDOG_MAX_DEPTH) g_frames[frame].waiting.store(waiting, std::memory_order_relaxed);
+    endChange(now);
+}
+
+WatchdogWait::WatchdogWait() : active(g_running.load(std::memory_order_relaxed)) {
+    if (active) setWaiting(g_depth.load(std::memory_order_relaxed) - 1, true);
+}
+
+WatchdogWait::~WatchdogWait() {
+    if (active) setWaiting(g_depth.load(std::memory_order_relaxed) - 1, false);
+}
+
+void watchdogModalLoop(bool entered) {
+    if (g_running.load(std::memory_order_relaxed)) setWaiting(g_depth.load(std::memory_order_relaxed) - 2, entered);
+}
+
+// ---------------- report ----------------
+StallReport stallReport() {
+    StallReport r = {};
+    r.thresholdMs = (int)(g_thresholdNs.load() / 1000000);
+    r.dispatches = g_dispatches.load();
+    std::lock_guard<std::mutex> lock(g_reportLock);
+    r.stalls = g_stalls;
+    r.stalledMs = g_stalledMs;
+    for (auto& kv : g_sites) {
+        StallSite s = kv.second.site;
+        s.dbActivity.assign(kv.second.db.begin(), kv.second.db.end());
+        std::stable_sort(s.dbActivity.begin(), s.dbActivity.end(),
+                         [](const std::pair<std::string, long long>& a, const std::pair<std::string, long long>& b) {
+                             return a.second > b.second;
+                         });
+        r.sites.push_back(std::move(s));
+    }
+    std::sort(r.sites.begin(), r.sites.end(),
+              [](const StallSite& a, const StallSite& b) { return a.totalMs > b.totalMs; });
+    // caught and not yet over: the handler is still running
+    if (g_caught.seq == g_beatSeq.load()) {
+        r.stalledNow = true;
+        r.now.code = g_caught.code;
+        r.now.message = g_caught.name;
+        r.now.handler = g_caught.handler;
+        r.now.stalls = 1;
+        r.now.dbActivity.emplace_back(g_caught.dbDetail, 1);
+        r.nowMs = (watchdogNowNs() - g_caught.startNs) / 1e6;
+    }
+    return r;
+}
+
+static std::string siteName(const StallSite& s) {
+    char code[32];
+    std::snprintf(code, sizeof(code), "message 0x%04X", s.code);
+    std::string out = s.message ? s.message : code;
+    out += " in ";
+    out += s.handler ? s.handler : "?";
+    return out;
+}
+
+std::string stallReportText(const StallReport& r) {
+    char line[256];
+    std::string out;
+    std::snprintf(line, sizeof(line), "stalls over %d ms: %lld of %lld handler calls, %.1f ms in all\n",
+                  r.thresholdMs, r.stalls, r.dispatches, r.stalledMs);
+    out += line;
+    if (r.stalledNow) {
+        std::snprintf(line, sizeof(line), "stalled now: %s for %.1f ms, db worker: %s\n", siteName(r.now).c_str(),
+                      r.nowMs, r.now.dbActivity.empty() ? "?" : r.now.dbActivity[0].first.c_str());
+        out += line;
+    }
+    if (r.sites.empty()) return out;
+    out += "\n  total ms   stalls     max ms  message in handler / db worker at the time\n";
+    for (auto& s : r.sites) {
+        std::snprintf(line, sizeof(line), "%10.1f %8lld %10.1f  %s\n", s.totalMs, s.stalls, s.maxMs,
+                      siteName(s).c_str());
+        out += line;
+        out += "                                 ";
+        for (size_t i = 0; i < s.dbActivity.size(); i++) {
+            out += i ? ", " : "";
+            out += s.dbActivity[i].first + " x" + std::to_string(s.dbActivity[i].second);
+        }
+        out += '\n';
+    }
+    return out;
+}
+
+// written to a temporary name and renamed, like the metrics file
+static void writeReportFile(const std::string& file) {
+    std::string text = stallReportText(stallReport());
+    fs::path path = fs::u8path(file);
+    fs::path tmp = path;
+    tmp += ".tmp";
+#ifdef _WIN32
+    FILE* f = _wfopen(tmp.c_str(), L"wb");
+#else
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+#endif
+    if (!f) return;
+    bool ok = std::fwrite(text.data(), 1, text.size(), f) == text.size();
+    if (std::fclose(f) != 0) ok = false;
+    std::error_code ec;
+    if (ok) fs::rename(tmp, path, ec);
+    if (!ok || ec) fs::remove(tmp, ec);
+}
+
+// ---------------- watchdog thread ----------------
+static std::mutex g_watchdogLock;
+static std::condition_variable g_watchdogWake;
+static bool g_watchdogStop = false; // under g_watchdogLock
+static std::thread g_watchdogThread;
+
+// "Search #12 (340 ms)": what db was busy with and for how long
+static void dbActivityNow(long long now, std::string& name, std::string& detail) {
+    const char* what = g_dbWhat.load(std::memory_order_acquire);
+    if (!what) {
+        name = detail = "idle";
+        return;
+    }
+    long long value = g_dbValue.load(std::memory_order_relaxed);
+    long long since = g_dbSinceNs.load(std::memory_order_relaxed);
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "%s #%lld (%.1f ms)", what, value, (now - since) / 1e6);
+    name = what;
+    detail = buf;
+}
+
+static void watchdogMain(std::string reportFile) {
+    TRACE_THREAD_NAME("watchdog");
+    long long threshold = g_thresholdNs.load();
+    // a few looks per threshold, so a stall is caught at most a quarter late
+    long long pollMs = std::min<long long>(std::max<long long>(threshold / 4000000, 5), 50);
+    unsigned long long caughtSeq = ~0ull;
+    std::unique_lock<std::mutex> lock(g_watchdogLock);
+    while (!g_watchdogStop) {
+        g_watchdogWake.wait_for(lock, std::chrono::milliseconds(pollMs));
+        if (g_watchdogStop) break;
+
+        unsigned long long seq = g_beatSeq.load(std::memory_order_acquire);
+        if (seq & 1) continue; // the UI thread is just beating: not stalled
+        long long beat = g_beatNs.load(std::memory_order_relaxed);
+        int depth = g_depth.load(std::memory_order_relaxed);
+        if (depth <= 0 || depth > WATCHDOG_MAX_DEPTH) continue;
+        const WatchdogFrame& top = g_frames[depth - 1];
+        CaughtStall c;
+        c.seq = seq;
+        c.code = top.code.load(std::memory_order_relaxed);
+        c.name = top.name.load(std::memory_order_relaxed);
+        c.handler = top.handler.load(std::memory_order_relaxed);
+        c.startNs = beat;
+        bool waiting = top.waiting.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (g_beatSeq.load(std::memory_order_relaxed) != seq) continue; // torn look
+
+        long long now = watchdogNowNs();
+        if (seq == caughtSeq || waiting || now - beat < threshold) continue;
+        caughtSeq = seq;
+        dbActivityNow(now, c.db, c.dbDetail);
+        {
+            std::lock_guard<std::mutex> report(g_reportLock);
+            g_caught = c;
+        }
+        if (!reportFile.empty()) writeReportFile(reportFile);
+    }
+}
+
+bool startWatchdog(int thresholdMs, const std::string& reportFile) {
+    if (g_watchdogThread.joinable() || thresholdMs <= 0) return false;
+    g_thresholdNs = (long long)thresholdMs * 1000000;
+    {
+        std::lock_guard<std::mutex> lock(g_reportLock);
+        g_reportFile = reportFile;
+    }
+    g_watchdogStop = false;
+    g_running = true;
+    g_watchdogThread = std::thread(watchdogMain, reportFile);
+    return true;
+}
+
+void stopWatchdog() {
+    if (!g_watchdogThread.joinable()) return;
+    g_running = false;
+    {
+        std::lock_guard<std::mutex> lock(g_watchdogLock);
+        g_watchdogStop = true;
+        g_watchdogWake.notify_one();
+    }
+    g_watchdogThread.join();
+    std::string file;
+    long long stalls;
+    {
+        std::lock_guard<std::mutex> lock(g_reportLock);
+        file = g_reportFile;
+        stalls = g_stalls;
+    }
+    // no stalls, no file
+    if (!file.empty() && stalls > 0) writeReportFile(file);
+}
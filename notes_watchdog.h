@@ -0,0 +1,90 @@
+// notes_watchdog.h
+// stall watchdog for the UI thread. every window procedure marks the message
+// it handles (a heartbeat at its start and end):
+//
+//   LRESULT CALLBACK GridWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+//       WatchdogDispatch dispatch(msg, traceMsgName(msg), "GridWndProc");
+//       ...
+//
+// a watchdog thread looks in every few ms; when one handler has gone longer
+// than the threshold without a heartbeat it notes which message and handler
+// it is and what the db worker is doing right then (DbActivityScope), and
+// rewrites the report file, so even a hang that never ends leaves a trace.
+// stalls are summed up per message and handler, most stalled time first.
+//
+// a handler that dispatches others (SendMessage, a modal loop) is only timed
+// between them: the inner handlers are the heartbeat. a handler waiting on
+// the user in a modal loop is not stalled: see WatchdogWait / watchdogModalLoop.
+// nothing here knows about Win32; message codes are just numbers.
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+
+const int STALL_MS = 100;           // default threshold
+const int WATCHDOG_MAX_DEPTH = 32; // nested dispatches tracked (deeper ones only beat)
+
+// ---------------- UI thread ----------------
+// name and handler must be string literals (or live as long as the
+// program); a null name is reported by its code
+struct WatchdogDispatch {
+    WatchdogDispatch(unsigned code, const char* name, const char* handler);
+    ~WatchdogDispatch();
+    bool active; // the watchdog was running when the handler started
+};
+
+// the running handler waits for the user (MessageBox ...) until the end of the scope
+struct WatchdogWait {
+    WatchdogWait();
+    ~WatchdogWait();
+    bool active;
+};
+
+// called from the handler of a notification that a modal loop started or
+// ended (WM_ENTERSIZEMOVE / WM_EXITSIZEMOVE, WM_ENTERMENULOOP / WM_EXITMENULOOP):
+// the handler that runs the loop is the one below the calling one
+void watchdogModalLoop(bool entered);
+
+// ---------------- db side ----------------
+// what the thread owning db is doing (one at a time; the worker marks each
+// request and commit). what must be a string literal, value is free.
+struct DbActivityScope {
+    DbActivityScope(const char* what, long long value = 0);
+    ~DbActivityScope();
+    const char* prevWhat; // the scope this one is nested in
+    long long prevValue;
+    long long prevSinceNs;
+};
+
+// ---------------- watchdog ----------------
+// start the watchdog thread; reportFile ("" = none) is rewritten with
+// stallReportText after each stall it catches and when it stops
+bool startWatchdog(int thresholdMs, const std::string& reportFile);
+void stopWatchdog();
+
+struct StallSite {
+    unsigned code;
+    const char* message; // null: not named, see code
+    const char* handler;
+    long long stalls;
+    double totalMs;      // the stalled stretches, threshold included
+    double maxMs;
+    // what db was doing when the watchdog caught it, most often first
+    // ("idle": nothing; "unseen": over before the watchdog looked)
+    std::vector<std::pair<std::string, long long>> dbActivity;
+};
+
+struct StallReport {
+    int thresholdMs;
+    long long dispatches; // handler calls seen
+    long long stalls;
+    double stalledMs;
+    std::vector<StallSite> sites; // most totalMs first
+    // a stall that is still going on (the handler has not returned)
+    bool stalledNow;
+    StallSite now;
+    double nowMs;
+};
+
+StallReport stallReport();
+std::string stallReportText(const StallReport& report);
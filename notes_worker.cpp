@@ -0,0 +1,423 @@
+// notes_worker.cpp
+#include "notes_worker.h"
+#include "notes_cache.h"
+#include "notes_metrics.h"
+#include "notes_search.h"
+#include "notes_trace.h"
+#include "notes_watchdog.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+struct DbRequest {
+    DbOp op;
+    uint64_t seq;
+    void* replyTo;
+    int id;
+    std::string text1; // Search/Page: query, Save: title
+    std::string text2; // Save: content
+    int beforeId;      // Page: keyset position
+    DbRequest* next;
+};
+
+// ---------------- lock-free inbox ----------------
+// producers push onto a Treiber stack; the worker takes the whole stack at once
+// and reverses it, so requests still run in submit order.
+static std::atomic<DbRequest*> g_inbox(nullptr);
+
+static std::thread g_workerThread;
+static DbResultCallback g_callback = nullptr;
+static std::atomic<bool> g_stopping(false);
+static std::atomic<uint64_t> g_nextSeq(1);
+static std::atomic<uint64_t> g_latestSearch(0);
+
+// only used to sleep/wake the worker, never held while touching the queue
+static std::mutex g_wakeLock;
+static std::condition_variable g_wake;
+
+// seq of the search currently inside SQLite (0 = none). changed under
+// g_interruptLock so sqlite3_interrupt can never hit a save that follows it.
+static std::mutex g_interruptLock;
+static uint64_t g_runningSearch = 0;
+
+// last search answer, so the next keystroke can be filtered in memory
+static SearchSession g_session;
+// recent answers (previews only) for backspacing and MSG_REFRESH re-runs
+static SearchResultCache g_resultCache;
+
+// query and mode of the last search result handed out, i.e. the list on screen
+static std::string g_shownQuery;
+static SearchMode g_shownMode = SearchMode::Like;
+
+// ---------------- write-behind saves ----------------
+// saves wait here (worker thread only) and are committed together, in one
+// transaction, once SAVE_BATCH_ROWS are queued or the oldest is SAVE_DELAY_MS old.
+// a second save of a queued note id replaces the text of the first.
+typedef std::chrono::steady_clock SaveClock;
+static std::vector<DbRequest*> g_pendingSaves;
+static std::unordered_map<int, size_t> g_pendingById; // existing notes only
+static SaveClock::time_point g_oldestSave;
+
+static std::atomic<long long> g_savesQueued(0);
+static std::atomic<long long> g_savesCoalesced(0);
+static std::atomic<long long> g_saveBatches(0);
+static std::atomic<long long> g_savesWritten(0);
+
+static void pushRequest(DbRequest* r) {
+    r->next = g_inbox.load(std::memory_order_relaxed);
+    while (!g_inbox.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    std::lock_guard<std::mutex> lock(g_wakeLock);
+    g_wake.notify_one();
+}
+
+static DbRequest* takeAll() {
+    DbRequest* list = g_inbox.exchange(nullptr, std::memory_order_acquire);
+    DbRequest* fifo = nullptr;
+    while (list) {
+        DbRequest* next = list->next;
+        list->next = fifo;
+        fifo = list;
+        list = next;
+    }
+    return fifo;
+}
+
+// ---------------- worker ----------------
+// turn the committed row changes into list patches for the shown query
+static void collectChanges(DbResult* res) {
+    if (!takeNoteChanges(res->changes) || !matchableInMemory(g_shownQuery, g_shownMode)) {
+        res->changes.clear();
+        res->fullRefresh = true;
+        return;
+    }
+    for (auto& c : res->changes) {
+        if (c.kind == ChangeKind::Deleted) continue;
+        if (!loadNote(c.id, c.note)) {
+            c.kind = ChangeKind::Deleted;
+            continue;
+        }
+        c.matches = noteMatchesQuery(c.note, g_shownQuery);
+        c.note.content = makePreview(c.note.content);
+    }
+}
+
+static const char* opName(DbOp op) {
+    switch (op) {
+    case DbOp::Search: return "search";
+    case DbOp::Page: return "page";
+    case DbOp::Save: return "save";
+    case DbOp::Load: return "load";
+    }
+    return "";
+}
+
+static void runRequest(DbRequest* r) {
+    TRACE_SCOPE_DETAIL("runRequest", opName(r->op), (long long)r->seq);
+    DbActivityScope activity(opName(r->op), (long long)r->seq);
+    DbResult* res = new DbResult();
+    res->op = r->op;
+    res->seq = r->seq;
+    res->replyTo = r->replyTo;
+    res->ok = false;
+    res->id = r->id;
+    res->fullRefresh = false;
+    res->beforeId = 0;
+    res->nextBefore = 0;
+    res->more = false;
+
+    switch (r->op) {
+    case DbOp::Search: {
+        {
+            std::lock_guard<std::mutex> lock(g_interruptLock);
+            g_runningSearch = r->seq;
+        }
+        res->query = r->text1;
+        // Like while the index is built, whatever was chosen: cache that under Like
+        SearchMode mode = effectiveSearchMode();
+        uint64_t generation = writeGeneration();
+        bool complete = true;
+        NotePage page;
+        if (!g_resultCache.get(r->text1, mode, generation, page)) {
+            complete = g_session.search(r->text1, FIRST_PAGE_ROWS, page);
+            if (complete) g_resultCache.put(r->text1, mode, generation, page);
+        }
+        res->notes.swap(page.notes);
+        res->nextBefore = page.nextBefore;
+        res->more = page.more;
+        {
+            std::lock_guard<std::mutex> lock(g_interruptLock);
+            g_runningSearch = 0;
+        }
+        // interrupted or overtaken while running: nobody wants this answer
+        res->ok = complete && (r->seq == g_latestSearch.load());
+        if (res->ok) {
+            g_shownQuery = r->text1;
+            g_shownMode = mode;
+        }
+        break;
+    }
+    case DbOp::Page: {
+        {
+            std::lock_guard<std::mutex> lock(g_interruptLock);
+            g_runningSearch = r->seq;
+        }
+        NotePage page;
+        bool complete = fetchNotePage(r->text1, r->beforeId, PAGE_ROWS, page);
+        {
+            std::lock_guard<std::mutex> lock(g_interruptLock);
+            g_runningSearch = 0;
+        }
+        res->ok = complete && (r->seq == g_latestSearch.load());
+        if (res->ok) {
+            g_session.extend(r->text1, r->beforeId, page);
+            res->query = r->text1;
+            res->notes.swap(page.notes);
+            res->beforeId = r->beforeId;
+            res->nextBefore = page.nextBefore;
+            res->more = page.more;
+        }
+        break;
+    }
+    case DbOp::Save:
+        break; // queued by queueSave, written by commitSaves
+    case DbOp::Load: {
+        Note n;
+        res->ok = loadNote(r->id, n);
+        if (res->ok) res->notes.push_back(std::move(n));
+        break;
+    }
+    }
+
+    if ((r->op == DbOp::Search || r->op == DbOp::Page) && !res->ok) {
+        delete res;
+        return;
+    }
+    if (g_callback) g_callback(res);
+    else delete res;
+}
+
+static DbResult* newSaveResult(const DbRequest* r) {
+    DbResult* res = new DbResult();
+    res->op = DbOp::Save;
+    res->seq = r->seq;
+    res->replyTo = r->replyTo;
+    res->ok = false;
+    res->id = r->id;
+    res->fullRefresh = false;
+    res->beforeId = 0;
+    res->nextBefore = 0;
+    res->more = false;
+    return res;
+}
+
+// write every queued save in one transaction and answer each of them;
+// the row changes of the whole batch go with the last answer
+static void commitSaves(bool durable) {
+    if (g_pendingSaves.empty()) return;
+    TRACE_SCOPE_DETAIL("commitSaves", durable ? "durable" : nullptr, (long long)g_pendingSaves.size());
+    DbActivityScope activity("commit saves", (long long)g_pendingSaves.size());
+    if (durable) sqlite3_exec(db, "PRAGMA synchronous = FULL;", nullptr, nullptr, nullptr);
+
+    std::vector<DbResult*> results;
+    results.reserve(g_pendingSaves.size());
+    bool inTransaction = beginWrite();
+    for (DbRequest* r : g_pendingSaves) {
+        DbResult* res = newSaveResult(r);
+        if (r->id > 0) {
+            res->ok = updateNotePrepared(r->id, r->text1, r->text2);
+        } else {
+            res->ok = insertNotePrepared(r->text1, r->text2);
+            if (res->ok) res->id = (int)sqlite3_last_insert_rowid(db);
+        }
+        results.push_back(res);
+        delete r;
+    }
+    if (inTransaction && !commitWrite()) {
+        rollbackWrite();
+        for (DbResult* res : results) res->ok = false;
+    }
+    g_saveBatches++;
+    g_savesWritten += (long long)results.size();
+    g_pendingSaves.clear();
+    g_pendingById.clear();
+
+    g_session.invalidate();
+    DbResult* last = results.back();
+    bool anyOk = false;
+    for (DbResult* res : results) anyOk = anyOk || res->ok;
+    if (anyOk) collectChanges(last);
+    else last->fullRefresh = true;
+    for (DbResult* res : results) {
+        if (g_callback) g_callback(res);
+        else delete res;
+    }
+}
+
+static void queueSave(DbRequest* r) {
+    g_savesQueued++;
+    if (r->id > 0) {
+        auto it = g_pendingById.find(r->id);
+        if (it != g_pendingById.end()) {
+            DbRequest* queued = g_pendingSaves[it->second];
+            queued->text1.swap(r->text1);
+            queued->text2.swap(r->text2);
+            queued->replyTo = r->replyTo;
+            g_savesCoalesced++;
+            delete r;
+            return;
+        }
+        g_pendingById[r->id] = g_pendingSaves.size();
+    }
+    if (g_pendingSaves.empty()) g_oldestSave = SaveClock::now();
+    g_pendingSaves.push_back(r);
+    if ((int)g_pendingSaves.size() >= SAVE_BATCH_ROWS) commitSaves(false);
+}
+
+static void workerMain(std::string path, std::promise<std::string>* opened) {
+    TRACE_THREAD_NAME("db worker");
+    if (!initDatabase(path.c_str())) {
+        opened->set_value(lastDbError().empty() ? "open failed" : lastDbError());
+        return;
+    }
+    opened->set_value("");
+
+    for (;;) {
+        DbRequest* batch = takeAll();
+        if (!batch) {
+            if (g_stopping) break;
+            std::unique_lock<std::mutex> lock(g_wakeLock);
+            auto woken = [] { return g_inbox.load() != nullptr || g_stopping.load(); };
+            // idle: still wake up for the queued saves and the next metrics sample
+            SaveClock::time_point saveDue = g_oldestSave + std::chrono::milliseconds(SAVE_DELAY_MS);
+            SaveClock::time_point due = dbMetricsDue();
+            if (!g_pendingSaves.empty()) due = std::min(due, saveDue);
+            if (!g_wake.wait_until(lock, due, woken)) {
+                lock.unlock();
+                if (!g_pendingSaves.empty() && SaveClock::now() >= saveDue) commitSaves(false);
+                sampleDbMetricsIfDue();
+            }
+            continue;
+        }
+        while (batch) {
+            DbRequest* r = batch;
+            batch = batch->next;
+            if (r->op == DbOp::Save) {
+                queueSave(r);
+                continue;
+            }
+            bool stale = ((r->op == DbOp::Search || r->op == DbOp::Page) && r->seq != g_latestSearch.load());
+            // on shutdown only saves still matter
+            if (g_stopping) stale = true;
+            // an editor opening a note must see its queued text. searches need no
+            // flush: the list is patched from the commit whenever it lands.
+            if (!stale && r->op == DbOp::Load && g_pendingById.count(r->id)) commitSaves(false);
+            if (!stale) runRequest(r);
+            delete r;
+        }
+        sampleDbMetricsIfDue();
+    }
+    // the last batch is synced to disk whatever the profile says
+    commitSaves(true);
+    sampleDbMetrics();
+    g_session.invalidate();
+    g_resultCache.clear();
+    closeDatabase();
+}
+
+bool startDbWorker(const char* path, DbResultCallback callback, std::string& err) {
+    if (g_workerThread.joinable()) return true;
+    g_callback = callback;
+    g_stopping = false;
+    std::promise<std::string> opened;
+    std::future<std::string> result = opened.get_future();
+    g_workerThread = std::thread(workerMain, std::string(path), &opened);
+    err = result.get();
+    if (!err.empty()) {
+        g_workerThread.join();
+        return false;
+    }
+    return true;
+}
+
+void stopDbWorker() {
+    if (!g_workerThread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(g_wakeLock);
+        g_stopping = true;
+        g_wake.notify_one();
+    }
+    g_workerThread.join();
+    g_callback = nullptr;
+}
+
+// ---------------- submit ----------------
+uint64_t submitSearch(const std::string& q, void* replyTo) {
+    DbRequest* r = new DbRequest();
+    r->op = DbOp::Search;
+    r->seq = g_nextSeq++;
+    r->replyTo = replyTo;
+    r->id = 0;
+    r->text1 = q;
+    uint64_t seq = r->seq; // r belongs to the worker once pushed
+    g_latestSearch = seq;
+    {
+        std::lock_guard<std::mutex> lock(g_interruptLock);
+        if (g_runningSearch != 0 && g_runningSearch < seq && db) sqlite3_interrupt(db);
+    }
+    pushRequest(r);
+    return seq;
+}
+
+void submitPage(uint64_t listSeq, const std::string& q, int beforeId, void* replyTo) {
+    DbRequest* r = new DbRequest();
+    r->op = DbOp::Page;
+    r->seq = listSeq; // lives and dies with the search that opened the list
+    r->replyTo = replyTo;
+    r->id = 0;
+    r->text1 = q;
+    r->beforeId = beforeId;
+    pushRequest(r);
+}
+
+void submitSave(int id, const std::string& title, const std::string& content, void* replyTo) {
+    DbRequest* r = new DbRequest();
+    r->op = DbOp::Save;
+    r->seq = g_nextSeq++;
+    r->replyTo = replyTo;
+    r->id = id;
+    r->text1 = title;
+    r->text2 = content;
+    pushRequest(r);
+}
+
+void submitLoad(int id, void* replyTo) {
+    DbRequest* r = new DbRequest();
+    r->op = DbOp::Load;
+    r->seq = g_nextSeq++;
+    r->replyTo = replyTo;
+    r->id = id;
+    pushRequest(r);
+}
+
+uint64_t latestSearchSeq() {
+    return g_latestSearch.load();
+}
+
+SearchCacheStats searchCacheStats() {
+    return g_resultCache.stats();
+}
+
+SaveQueueStats saveQueueStats() {
+    SaveQueueStats s;
+    s.queued = g_savesQueued;
+    s.coalesced = g_savesCoalesced;
+    s.batches = g_saveBatches;
+    s.written = g_savesWritten;
+    return s;
+}
@@ -0,0 +1,77 @@
+// notes_worker.h
+// database worker thread: owns the sqlite3 connection so the UI thread never
+// waits on SQLite. requests go in through a lock-free queue, results come back
+// through a callback (main.cpp turns that into a PostMessage).
+#pragma once
+#include "notes_cache.h"
+#include "notes_changes.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class DbOp { Search, Page, Save, Load };
+
+// a search answers with the first rows only; the list asks for the rest
+// page by page as it scrolls towards the end of what it has
+const int FIRST_PAGE_ROWS = 48;
+const int PAGE_ROWS = 256;
+
+// saves are written behind: queued on the worker and committed together once
+// this many are waiting or the oldest has waited this long
+const int SAVE_BATCH_ROWS = 64;
+const int SAVE_DELAY_MS = 25;
+
+struct DbResult {
+    DbOp op;
+    uint64_t seq;
+    void* replyTo;
+    bool ok;
+    int id;                  // Save: id written (new id for inserts), Load: id asked for
+    std::string query;       // Search/Page: the query this answers
+    std::vector<Note> notes; // Search/Page: matches (previews), Load: the note (if found)
+
+    // Search/Page: keyset position, see NotePage. beforeId is where this page starts.
+    int beforeId;
+    int nextBefore;
+    bool more;
+
+    // Save: rows that changed, checked against the query of the list on screen.
+    // fullRefresh means they can't be patched in (re-run the search instead).
+    // saves committed together share one list of changes, on the last answer.
+    std::vector<NoteChange> changes;
+    bool fullRefresh;
+};
+
+// runs on the worker thread and takes ownership of result (delete it when done)
+typedef void (*DbResultCallback)(DbResult* result);
+
+// opens path on a new worker thread; false (and err) if the database can't be opened
+bool startDbWorker(const char* path, DbResultCallback callback, std::string& err);
+// writes every queued save (synchronous=FULL, whatever the profile), then
+// closes the connection and joins the thread
+void stopDbWorker();
+
+// a newer search makes older ones stale: queued ones are dropped and a running
+// one is cancelled with sqlite3_interrupt, so only the latest seq gets a result
+uint64_t submitSearch(const std::string& q, void* replyTo);
+// the next rows (id < beforeId) of the list opened by search listSeq.
+// answered with a Page result, dropped if a newer search came in meanwhile.
+void submitPage(uint64_t listSeq, const std::string& q, int beforeId, void* replyTo);
+// id 0 inserts a new note. returns at once; the write is committed with the
+// next batch and answered with a Save result. saving a note id that is still
+// queued replaces the queued text (one answer for both).
+void submitSave(int id, const std::string& title, const std::string& content, void* replyTo);
+void submitLoad(int id, void* replyTo);
+
+uint64_t latestSearchSeq();
+
+// search results the worker serves from its LRU instead of SQLite
+SearchCacheStats searchCacheStats();
+
+struct SaveQueueStats {
+    long long queued;    // submitSave calls
+    long long coalesced; // replaced a queued save of the same note
+    long long batches;   // transactions committed
+    long long written;   // rows written by them
+};
+SaveQueueStats saveQueueStats();